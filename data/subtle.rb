@@ -25,6 +25,9 @@ set :increase_step, 5
 # Window screen border snapping
 set :border_snap, 10
 
+# Snap windows to edges of neighbor windows while moving them with the pointer
+set :client_snap, false
+
 # Default starting gravity for windows. Comment out to use gravity of
 # currently active client
 set :default_gravity, :center
@@ -47,6 +50,9 @@ set :skip_pointer_warp, false
 # Skip pointer movement to urgent windows
 set :skip_urgent_warp, false
 
+# Maximum panel refreshes per second for sublet updates, 0 disables the limit
+# set :panel_fps, 30
+
 # Set the WM_NAME of subtle (Java quirk)
 # set :wmname, "LG3D"
 
@@ -554,6 +560,13 @@ end
 #                Links:   http://subforge.org/projects/subtle/wiki/Tagging#Resize
 #                         http://subforge.org/projects/subtle/wiki/Clients#Resize
 #
+# [*retag*]      This property checks name matchers of this tag again whenever
+#                the title of a client changes, so clients can gain or lose the
+#                tag later on. Title changes are collected for a short moment
+#                before checking.
+#
+#                Example: retag true
+#
 # [*stick*]      This property enables the stick mode for tagged clients. When set,
 #                clients are visible on all views, even when they don't have matching
 #                tags. On multihead, sticky clients keep the screen they are assigned
@@ -715,6 +728,15 @@ end
 #
 #                Example: icon_only true
 #
+# [*layout*]     This property arranges all tiled windows of the view at once
+#                instead of using their gravities. Available layouts are
+#                :master, :grid, :spiral and :monocle; :master and :spiral
+#                accept the share of the first windows as ratio and :master
+#                the number of master windows.
+#
+#                Example: layout :grid
+#                         layout :master, ratio: 0.6, master: 1
+#
 #
 # === Link
 #
@@ -805,6 +827,29 @@ view "dev",   "editor"
 #     puts c.name
 #   end
 #
+# Client hooks accept the matchers of tags as filter, so the block is only
+# called for matching windows:
+#
+#   on :client_create, class: /term/ do |c|
+#     puts c.name
+#   end
+#
+# Hooks receive one shared Subtlext::Client per window, which is updated in
+# place before every call. A client kept from an earlier call therefore
+# always shows the current state; use +dup+ to keep a snapshot:
+#
+#   on :client_focus do |c|
+#     @last = c.dup
+#   end
+#
+# The tile hook optionally receives the changes since the last tile event
+# as hash with the keys :added, :moved, :shown and :hidden (clients) and
+# :removed (window ids):
+#
+#   on :tile do |delta|
+#     delta[:added].each { |c| puts c.name }
+#   end
+#
 # === Link
 #
 # http://subforge.org/projects/subtle/wiki/Hooks
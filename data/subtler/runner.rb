@@ -72,6 +72,7 @@ module Subtle # {{{
           [ '--reload',  '-r', GetoptLong::NO_ARGUMENT       ],
           [ '--restart', '-R', GetoptLong::NO_ARGUMENT       ],
           [ '--quit',    '-q', GetoptLong::NO_ARGUMENT       ],
+          [ '--stats',   '-Z', GetoptLong::NO_ARGUMENT       ],
           [ '--current', '-C', GetoptLong::NO_ARGUMENT       ],
           [ '--select',  '-X', GetoptLong::NO_ARGUMENT       ],
           [ '--proc',    '-p', GetoptLong::REQUIRED_ARGUMENT ],
@@ -127,6 +128,7 @@ module Subtle # {{{
             when '--reload'  then @mod = :reload
             when '--restart' then @mod = :restart
             when '--quit'    then @mod = :quit
+            when '--stats'   then @mod = :stats
             when '--current' then @mod = :current
             when '--select'  then @mod = :select
 
@@ -180,6 +182,10 @@ module Subtle # {{{
           when :reload  then  Subtlext::Subtle.reload
           when :restart then  Subtlext::Subtle.restart
           when :quit    then  Subtlext::Subtle.quit
+          when :stats
+            Subtlext::Subtle.stats.each do |k, v|
+              puts '%-6s %d' % [ k, v ]
+            end
           when :current
             arg2 = arg1
             arg1 = :current
@@ -239,7 +245,7 @@ module Subtle # {{{
                   handle_result(obj.send(@action))
                 end
             end
-          elsif :reload != @mod and :restart != @mod and :quit != @mod
+          elsif ![ :reload, :restart, :quit, :stats ].include?(@mod)
             usage(@group)
             exit
           end
@@ -341,6 +347,7 @@ module Subtle # {{{
     -r, --reload           Reload config and sublets
     -R, --restart          Restart subtle
     -q, --quit             Quit subtle
+    -Z, --stats            Show GC stats of subtle
     -C, --current          Select current active window/view
                            instead of passing it via argument
     -X, --select           Select a window via pointer instead
@@ -16,6 +16,80 @@
 #include <sys/time.h>
 #include "shared.h"
 
+/* Typedef {{{ */
+typedef struct sharedicon_t
+{
+  Pixmap        pixmap, colored;
+  long          fg, bg;
+  int           depth, width, height;
+  unsigned long used;
+} SharedIcon;
+/* }}} */
+
+/* Globals {{{ */
+static SharedIcon icons[ICONCACHESIZE];
+static unsigned long iconticks = 0;
+#ifndef SUBTLE
+static SubSharedDirect *direct = NULL;
+#endif /* SUBTLE */
+/* }}} */
+
+/* Private */
+
+/* SharedIconCacheGet {{{ */
+static Pixmap
+SharedIconCacheGet(Display *disp,
+  GC gc,
+  int width,
+  int height,
+  long fg,
+  long bg,
+  Pixmap pixmap)
+{
+  int i, depth = DefaultDepth(disp, DefaultScreen(disp));
+  SharedIcon *lru = &icons[0];
+  XGCValues gvals;
+
+  /* Find colorized copy or least recently used slot */
+  for(i = 0; i < ICONCACHESIZE; i++)
+    {
+      SharedIcon *e = &icons[i];
+
+      if(None != e->colored && e->pixmap == pixmap && e->fg == fg &&
+          e->bg == bg && e->depth == depth && e->width == width &&
+          e->height == height)
+        {
+          e->used = ++iconticks;
+
+          return e->colored;
+        }
+
+      if(e->used < lru->used) lru = e;
+    }
+
+  /* Evict slot */
+  if(None != lru->colored) XFreePixmap(disp, lru->colored);
+
+  lru->pixmap  = pixmap;
+  lru->fg      = fg;
+  lru->bg      = bg;
+  lru->depth   = depth;
+  lru->width   = width;
+  lru->height  = height;
+  lru->used    = ++iconticks;
+  lru->colored = XCreatePixmap(disp, DefaultRootWindow(disp),
+    width, height, depth);
+
+  /* Colorize once */
+  gvals.foreground = fg;
+  gvals.background = bg;
+  XChangeGC(disp, gc, GCForeground|GCBackground, &gvals);
+
+  XCopyPlane(disp, pixmap, lru->colored, gc, 0, 0, width, height, 0, 0, 1);
+
+  return lru->colored;
+} /* }}} */
+
 /* Memory */
 
  /** subSharedMemoryAlloc {{{
@@ -159,6 +233,13 @@ subSharedPropertyGet(Display *disp,
 
   assert(win);
 
+#ifndef SUBTLE
+  /* Read live values when running inside of subtle */
+  if(direct && (data = (unsigned char *)direct->property(disp, win,
+      type, prop, size)))
+    return (char *)data;
+#endif /* SUBTLE */
+
   /* Get property */
   if(Success != XGetWindowProperty(disp, win, prop, 0L, 4096,
       False, type, &rtype, &format, &nitems, &bytes, &data))
@@ -457,19 +538,47 @@ subSharedDrawIcon(Display *disp,
   Pixmap pixmap,
   int bitmap)
 {
-  XGCValues gvals;
-
-  /* Plane color */
-  gvals.foreground = fg;
-  gvals.background = bg;
-  XChangeGC(disp, gc, GCForeground|GCBackground, &gvals);
-
   /* Copy icon to destination window */
   if(bitmap)
-    XCopyPlane(disp, pixmap, win, gc, 0, 0, width, height, x, y, 1);
+    {
+      /* Bitmaps are colorized once and copied afterwards */
+      XCopyArea(disp, SharedIconCacheGet(disp, gc, width, height, fg, bg,
+        pixmap), win, gc, 0, 0, width, height, x, y);
+    }
 #ifdef HAVE_X11_XPM_H
   else XCopyArea(disp, pixmap, win, gc, 0, 0, width, height, x, y);
 #endif /* HAVE_X11_XPM_H */
+} /* }}} */
+
+ /** subSharedDrawIconFlush {{{
+  * @brief Drop pre-colorized icons
+  * @param[in]  disp    Display
+  * @param[in]  pixmap  Source pixmap or \p None for all
+  **/
+
+void
+subSharedDrawIconFlush(Display *disp,
+  Pixmap pixmap)
+{
+  int i;
+
+  /* Free matching cache entries */
+  for(i = 0; i < ICONCACHESIZE; i++)
+    {
+      if(None != icons[i].colored &&
+          (None == pixmap || icons[i].pixmap == pixmap))
+        {
+          XFreePixmap(disp, icons[i].colored);
+
+          icons[i].pixmap  = None;
+          icons[i].colored = None;
+        }
+    }
+
+#ifndef SUBTLE
+  /* Pixmap ids get reused, drop copies subtle made of this one too */
+  if(direct && direct->flush) direct->flush(pixmap);
+#endif /* SUBTLE */
 } /* }}} */
 
 /* Font */
@@ -749,6 +858,110 @@ subSharedStringWidth(Display *disp,
   return center ? width - abs(lbearing - rbearing) : width;
 } /* }}} */
 
+ /** subSharedStringHash {{{
+  * @brief Get 64bit FNV-1a hash of string, used for name lookups
+  * @param[in]  str  The string
+  * @return Hash of the string
+  **/
+
+unsigned long long
+subSharedStringHash(const char *str)
+{
+  unsigned long long hash = 14695981039346656037ULL;
+
+  assert(str);
+
+  for(; *str; str++)
+    hash = (hash ^ (unsigned char)*str) * 1099511628211ULL;
+
+  return hash;
+} /* }}} */
+
+/* Tags */
+
+ /** subSharedTagsToCards {{{
+  * @brief Convert tags to cardinals for properties, trailing empty
+  *        cardinals are dropped
+  * @param[in]     tags   A #SubTags
+  * @param[inout]  cards  Cardinals, must hold #TAGSCARDS values
+  * @return Number of used cardinals
+  **/
+
+int
+subSharedTagsToCards(SubTags *tags,
+  long *cards)
+{
+  int i, n = 1;
+
+  assert(tags && cards);
+
+  for(i = 0; i < TAGSCARDS; i++)
+    {
+      cards[i] = (tags->bits[(i * 32) / TAGSBITS] >>
+        ((i * 32) % TAGSBITS)) & 0xffffffffUL;
+
+      if(cards[i]) n = i + 1;
+    }
+
+  return n;
+} /* }}} */
+
+ /** subSharedTagsFromCards {{{
+  * @brief Convert cardinals of properties and messages to tags
+  * @param[inout]  tags    A #SubTags
+  * @param[in]     cards   Cardinals
+  * @param[in]     ncards  Number of cardinals
+  **/
+
+void
+subSharedTagsFromCards(SubTags *tags,
+  long *cards,
+  unsigned long ncards)
+{
+  unsigned long i;
+
+  assert(tags);
+
+  subSharedTagsClear(tags);
+
+  for(i = 0; cards && i < ncards && i < TAGSCARDS; i++)
+    tags->bits[(i * 32) / TAGSBITS] |= ((unsigned long)cards[i] &
+      0xffffffffUL) << ((i * 32) % TAGSBITS);
+} /* }}} */
+
+ /** subSharedTagsRemove {{{
+  * @brief Remove id from tags and move all higher ids down by one
+  * @param[inout]  tags  A #SubTags
+  * @param[in]     id    Id to remove
+  **/
+
+void
+subSharedTagsRemove(SubTags *tags,
+  int id)
+{
+  unsigned int i, word = 0;
+  unsigned long low = 0;
+
+  assert(tags);
+
+  if(0 > id || TAGSMAX <= id) return;
+
+  word = (id + 1) / TAGSBITS;
+  low  = (1UL << ((id + 1) % TAGSBITS)) - 1;
+
+  /* Shift whole words and carry lowest bit of next word */
+  for(i = word; i < TAGSWORDS; i++)
+    {
+      unsigned long next = i + 1 < TAGSWORDS ? tags->bits[i + 1] & 1UL : 0;
+
+      if(i == word)
+        tags->bits[i] = (tags->bits[i] & low) | ((tags->bits[i] >> 1) & ~low);
+      else tags->bits[i] >>= 1;
+
+      tags->bits[i] |= next << (TAGSBITS - 1);
+    }
+} /* }}} */
+
 #ifndef SUBTLE
 
  /** subSharedMessage {{{
@@ -791,6 +1004,9 @@ subSharedMessage(Display *disp,
   ev.xclient.data.l[3] = data.l[3];
   ev.xclient.data.l[4] = data.l[4];
 
+  /* Skip the roundtrip when running inside of subtle */
+  if(direct && direct->message(disp, &ev.xclient)) return True;
+
   status = XSendEvent(disp, DefaultRootWindow(disp), False, mask, &ev);
 
   if(True == xsync) XSync(disp, False);
@@ -798,6 +1014,17 @@ subSharedMessage(Display *disp,
   return status;
 } /* }}} */
 
+ /** subSharedDirect {{{
+  * @brief Set handlers to bypass X when loaded into subtle
+  * @param[in]  d  A #SubSharedDirect or \p NULL
+  **/
+
+void
+subSharedDirect(SubSharedDirect *d)
+{
+  direct = d;
+} /* }}} */
+
 #endif /* SUBTLE */
 
 // vim:ts=2:bs=2:sw=2:et:fdm=marker
@@ -45,6 +45,13 @@
   __FILE__, __LINE__, #r, r.x, r.y, r.width, r.height);           ///< Print a XRectangle
 
 #define DEFFONT   "-*-*-*-*-*-*-14-*-*-*-*-*-*-*"                 ///< Default font
+#define ICONCACHESIZE 32                                          ///< Colorized icon cache size
+
+#define TAGSSIZE  256                                             ///< Bits per tag set
+#define TAGSBITS  (8 * sizeof(unsigned long))                     ///< Bits per tag word
+#define TAGSWORDS (TAGSSIZE / TAGSBITS)                           ///< Words per tag set
+#define TAGSCARDS (TAGSSIZE / 32)                                 ///< CARD32 per tag set
+#define TAGSMAX   (TAGSSIZE - 1)                                  ///< Max number of ids
 
 #define DATA(d)   ((SubData)d)                                    ///< Cast to SubData
 #define FONT(f)   ((SubFont *)f)                                  ///< Cast to SubFont
@@ -106,6 +113,19 @@ typedef union submessagedata_t /* {{{ */
   short s[10];                                                    ///< MessageData short
   long  l[5];                                                     ///< MessageData long
 } SubMessageData; /* }}} */
+
+typedef struct subshareddirect_t /* {{{ */
+{
+  int  (*message)(Display *disp, XClientMessageEvent *ev);        ///< Direct message handler
+  char *(*property)(Display *disp, Window win, Atom type, Atom prop,
+    unsigned long *size);                                         ///< Direct property getter
+  void (*flush)(Pixmap pixmap);                                   ///< Direct icon cache flush
+} SubSharedDirect; /* }}} */
+
+typedef struct subtags_t /* {{{ */
+{
+  unsigned long bits[TAGSWORDS];                                  ///< Tags bits
+} SubTags; /* }}} */
 /* }}} */
 
 /* Memory {{{ */
@@ -140,6 +160,7 @@ void subSharedPropertyDelete(Display *disp, Window win,
 void subSharedDrawIcon(Display *disp, GC gc, Window win,
   int x, int y, int width, int height, long fg, long bg,
   Pixmap pixmap, int bitmap);                                     ///< Draw icons
+void subSharedDrawIconFlush(Display *disp, Pixmap pixmap);        ///< Drop colorized icons
 void subSharedDrawString(Display *disp, GC gc, SubFont *f,
   Window win, int x, int y, long fg, long bg,
   const char *text, int len);                                     ///< Draw text
@@ -157,6 +178,116 @@ KeySym subSharedParseKey(Display *disp, const char *key,
 pid_t subSharedSpawn(char *cmd);                                  ///< Spawn command
 int subSharedStringWidth(Display *disp, SubFont *f,
   const char *text, int len, int *left, int *right, int center);  ///< Get text width
+unsigned long long subSharedStringHash(const char *str);          ///< Get 64bit hash of string
+/* }}} */
+
+/* Tags {{{ */
+int subSharedTagsToCards(SubTags *tags, long *cards);             ///< Convert tags to cardinals
+void subSharedTagsFromCards(SubTags *tags, long *cards,
+  unsigned long ncards);                                          ///< Convert cardinals to tags
+void subSharedTagsRemove(SubTags *tags, int id);                  ///< Remove id and shift tags
+
+/*
+ * Id n is stored as bit n + 1, so the first word stays compatible with the
+ * old single cardinal masks. All set operations work on whole words.
+ */
+
+/* subSharedTagsSet {{{ */
+static inline void
+subSharedTagsSet(SubTags *tags,
+  int id)
+{
+  if(0 <= id && TAGSMAX > id)
+    tags->bits[(id + 1) / TAGSBITS] |= (1UL << ((id + 1) % TAGSBITS));
+} /* }}} */
+
+/* subSharedTagsUnset {{{ */
+static inline void
+subSharedTagsUnset(SubTags *tags,
+  int id)
+{
+  if(0 <= id && TAGSMAX > id)
+    tags->bits[(id + 1) / TAGSBITS] &= ~(1UL << ((id + 1) % TAGSBITS));
+} /* }}} */
+
+/* subSharedTagsTest {{{ */
+static inline int
+subSharedTagsTest(const SubTags *tags,
+  int id)
+{
+  return (0 <= id && TAGSMAX > id &&
+    tags->bits[(id + 1) / TAGSBITS] & (1UL << ((id + 1) % TAGSBITS)));
+} /* }}} */
+
+/* subSharedTagsOr {{{ */
+static inline void
+subSharedTagsOr(SubTags *tags,
+  const SubTags *other)
+{
+  unsigned int i;
+
+  for(i = 0; i < TAGSWORDS; i++) tags->bits[i] |= other->bits[i];
+} /* }}} */
+
+/* subSharedTagsAnd {{{ */
+static inline void
+subSharedTagsAnd(SubTags *tags,
+  const SubTags *other)
+{
+  unsigned int i;
+
+  for(i = 0; i < TAGSWORDS; i++) tags->bits[i] &= other->bits[i];
+} /* }}} */
+
+/* subSharedTagsAndNot {{{ */
+static inline void
+subSharedTagsAndNot(SubTags *tags,
+  const SubTags *other)
+{
+  unsigned int i;
+
+  for(i = 0; i < TAGSWORDS; i++) tags->bits[i] &= ~other->bits[i];
+} /* }}} */
+
+/* subSharedTagsAny {{{ */
+static inline int
+subSharedTagsAny(const SubTags *tags,
+  const SubTags *other)
+{
+  unsigned int i;
+  unsigned long any = 0;
+
+  for(i = 0; i < TAGSWORDS; i++) any |= tags->bits[i] & other->bits[i];
+
+  return 0 != any;
+} /* }}} */
+
+/* subSharedTagsEmpty {{{ */
+static inline int
+subSharedTagsEmpty(const SubTags *tags)
+{
+  unsigned int i;
+  unsigned long any = 0;
+
+  for(i = 0; i < TAGSWORDS; i++) any |= tags->bits[i];
+
+  return 0 == any;
+} /* }}} */
+
+/* subSharedTagsEqual {{{ */
+static inline int
+subSharedTagsEqual(const SubTags *tags,
+  const SubTags *other)
+{
+  return 0 == memcmp(tags->bits, other->bits, sizeof(tags->bits));
+} /* }}} */
+
+/* subSharedTagsClear {{{ */
+static inline void
+subSharedTagsClear(SubTags *tags)
+{
+  memset(tags->bits, 0, sizeof(tags->bits));
+} /* }}} */
 /* }}} */
 
 #ifndef SUBTLE
@@ -164,6 +295,7 @@ int subSharedStringWidth(Display *disp, SubFont *f,
 /* Message {{{ */
 int subSharedMessage(Display *disp, Window win, char *type,
   SubMessageData data, int format, int xsync);                    ///< Send client message
+void subSharedDirect(SubSharedDirect *d);                         ///< Set in-process handlers
 /* }}} */
 
 #endif /* SUBTLE */
@@ -12,6 +12,39 @@
 
 #include "subtle.h"
 
+#define ARRAYMIN 4 ///< Minimum capacity
+
+/* Private */
+
+/* ArrayResize {{{ */
+static void
+ArrayResize(SubArray *a,
+  int size)
+{
+  a->data = (void **)subSharedMemoryRealloc(a->data, size * sizeof(void *));
+  a->size = size;
+} /* }}} */
+
+/* ArrayGrow {{{ */
+static void
+ArrayGrow(SubArray *a)
+{
+  /* Double capacity when full */
+  if(a->ndata == a->size)
+    ArrayResize(a, MAX(ARRAYMIN, 2 * a->size));
+} /* }}} */
+
+/* ArrayShrink {{{ */
+static void
+ArrayShrink(SubArray *a)
+{
+  /* Halve capacity when only a quarter is used to avoid thrashing */
+  if(ARRAYMIN < a->size && a->ndata < a->size / 4)
+    ArrayResize(a, MAX(ARRAYMIN, a->size / 2));
+} /* }}} */
+
+/* Public */
+
  /** subArrayNew {{{
   * @brief Create new array and init it
   * @return Returns a #SubArray or \p NULL
@@ -37,7 +70,8 @@ subArrayPush(SubArray *a,
 
   if(elem)
     {
-      a->data = (void **)subSharedMemoryRealloc(a->data, (a->ndata + 1) * sizeof(void *));
+      ArrayGrow(a);
+
       a->data[(a->ndata)++] = elem;
     }
 } /* }}} */
@@ -54,20 +88,18 @@ subArrayInsert(SubArray *a,
   int pos,
   void *elem)
 {
-  int i;
-
   assert(a && elem);
 
   /* Check boundaries */
-  if(pos < a->ndata)
+  if(0 <= pos && pos < a->ndata)
     {
-      a->ndata++;
-      a->data = (void **)subSharedMemoryRealloc(a->data, a->ndata * sizeof(void *));
+      ArrayGrow(a);
 
-      for(i = a->ndata - 1; i > pos; i--)
-        a->data[i] = a->data[i - 1];
+      memmove(a->data + pos + 1, a->data + pos,
+        (a->ndata - pos) * sizeof(void *));
 
       a->data[pos] = elem;
+      a->ndata++;
     }
   else subArrayPush(a, elem);
 } /* }}} */
@@ -82,20 +114,59 @@ void
 subArrayRemove(SubArray *a,
   void *elem)
 {
-  int i, idx;
+  int idx;
 
   assert(a && elem);
 
   if(0 <= (idx = subArrayIndex(a, elem)))
     {
-      for(i = idx; i < a->ndata - 1; i++)
-        a->data[i] = a->data[i + 1];
-
       a->ndata--;
-      a->data = (void **)subSharedMemoryRealloc(a->data, a->ndata * sizeof(void *));
+
+      memmove(a->data + idx, a->data + idx + 1,
+        (a->ndata - idx) * sizeof(void *));
+
+      ArrayShrink(a);
     }
 } /* }}} */
 
+ /** subArrayRemoveUnordered {{{
+  * @brief Remove element from array without keeping the order
+  * @param[in]  a     A #SubArray
+  * @param[in]  elem  Array element
+  **/
+
+void
+subArrayRemoveUnordered(SubArray *a,
+  void *elem)
+{
+  int idx;
+
+  assert(a && elem);
+
+  /* Move last element into the gap */
+  if(0 <= (idx = subArrayIndex(a, elem)))
+    {
+      a->data[idx] = a->data[--(a->ndata)];
+
+      ArrayShrink(a);
+    }
+} /* }}} */
+
+ /** subArrayReserve {{{
+  * @brief Make room for at least given number of elements
+  * @param[in]  a     A #SubArray
+  * @param[in]  size  Number of elements
+  **/
+
+void
+subArrayReserve(SubArray *a,
+  int size)
+{
+  assert(a);
+
+  if(a->size < size) ArrayResize(a, size);
+} /* }}} */
+
  /** subArrayGet {{{
   * @brief Get id after boundary check
   * @param[in]  a    A #SubArray
@@ -185,6 +256,7 @@ subArrayClear(SubArray *a,
 
       a->data  = NULL;
       a->ndata = 0;
+      a->size  = 0;
     }
 } /* }}} */
 
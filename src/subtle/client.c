@@ -11,6 +11,7 @@
   **/
 
 #include <X11/Xatom.h>
+#include <X11/Xresource.h>
 #include "subtle.h"
 
 /* Flags {{{ */
@@ -41,6 +42,23 @@ ClientMask(XRectangle *geom)
     geom->width + 1, geom->height + 1);
 } /* }}} */
 
+/* ClientIntern {{{ */
+static char *
+ClientIntern(char *str)
+{
+  char *ret = NULL;
+
+  /* Share one copy per string, quarks are never freed */
+  if(str)
+    {
+      ret = XrmQuarkToString(XrmStringToQuark(str));
+
+      free(str);
+    }
+
+  return ret;
+} /* }}} */
+
 /* ClientGravity {{{ */
 int
 ClientGravity(void)
@@ -52,7 +70,7 @@ ClientGravity(void)
   if(-1 == subtle->gravity)
     {
       /* Copy gravity from current client */
-      if((c = CLIENT(subSubtleFind(subtle->windows.focus[0], CLIENTID))))
+      if((c = CLIENT(subSubtleFind(subtle->windows.focus, CLIENTID))))
         grav = c->gravityid;
     }
   else grav = subtle->gravity; ///< Set default
@@ -177,13 +195,16 @@ ClientTile(int gravity,
   SubScreen *s = SCREEN(subArrayGet(subtle->screens, screen));
   SubGravity *g = GRAVITY(subArrayGet(subtle->gravities, gravity));
 
+  /* Layout of view replaces gravity tiling */
+  if(subClientLayout(screen)) return;
+
   /* Pass 1: Count clients with this gravity */
   for(i = 0; i < subtle->clients->ndata; i++)
     {
       SubClient *c = CLIENT(subtle->clients->data[i]);
 
       if(c->gravityid == gravity && c->screenid == screen &&
-        subtle->visible_tags & c->tags &&
+        subSharedTagsAny(&subtle->visible_tags, &c->tags) &&
         !(c->flags &(SUB_CLIENT_MODE_FLOAT|SUB_CLIENT_MODE_FULL))) used++;
     }
 
@@ -209,7 +230,7 @@ ClientTile(int gravity,
       SubClient *c = CLIENT(subtle->clients->data[i]);
 
       if(c->gravityid == gravity && c->screenid == screen &&
-          subtle->visible_tags & c->tags &&
+          subSharedTagsAny(&subtle->visible_tags, &c->tags) &&
           !(c->flags & (SUB_CLIENT_MODE_FLOAT|SUB_CLIENT_MODE_FULL)))
         {
           if(g->flags & SUB_GRAVITY_HORZ)
@@ -319,6 +340,50 @@ ClientCompare(const void *a,
   return ret;
 } /* }}} */
 
+/* ClientRecentUnlink {{{ */
+static int
+ClientRecentUnlink(SubClient *c)
+{
+  int i;
+
+  /* Check whether client is part of the history */
+  if(!c->prev && subtle->recent != c) return False;
+
+  /* Pass screen head on to the next recent client of the screen */
+  if(c->sprev) c->sprev->snext = c->snext;
+  else
+    {
+      for(i = 0; i < subtle->screens->ndata; i++)
+        {
+          SubScreen *s = SCREEN(subtle->screens->data[i]);
+
+          if(s->focus == c) s->focus = c->snext;
+        }
+    }
+  if(c->snext) c->snext->sprev = c->sprev;
+
+  if(c->prev) c->prev->next = c->next;
+  else subtle->recent = c->next;
+  if(c->next) c->next->prev = c->prev;
+
+  c->prev = c->next = c->sprev = c->snext = NULL;
+  subtle->nrecent--;
+
+  return True;
+} /* }}} */
+
+/* ClientRecentPublish {{{ */
+static void
+ClientRecentPublish(void)
+{
+  Window win = subtle->recent ? subtle->recent->win : None;
+
+  /* EWMH: Active window, the history is published when idle */
+  subEwmhSetWindows(ROOT, SUB_EWMH_NET_ACTIVE_WINDOW, &win, 1);
+
+  subtle->flags |= SUB_SUBTLE_HISTORY;
+} /* }}} */
+
 /* Public */
 
  /** subClientNew {{{
@@ -344,13 +409,17 @@ subClientNew(Window win)
   if(True == attrs.override_redirect) return NULL;
 
   /* Create new client */
-  c = CLIENT(subSharedMemoryAlloc(1, sizeof(SubClient)));
+  c = CLIENT(subPoolAlloc(subtle->pools.clients));
   c->gravities = (int *)subSharedMemoryAlloc(subtle->views->ndata, sizeof(int));
   c->flags     = (SUB_TYPE_CLIENT|SUB_CLIENT_INPUT);
   c->gravityid = -1; ///< Force update
   c->dir       = -1;
   c->win       = win;
 
+  /* Not reported to tile hook yet */
+  c->tilescreenid  = -2;
+  c->tilegravityid = -1;
+
   /* Window attributes */
   c->cmap        = attrs.colormap;
   c->geom.x      = attrs.x;
@@ -369,6 +438,11 @@ subClientNew(Window win)
   c->role = subSharedPropertyGet(subtle->dpy, c->win, XA_STRING,
     subEwmhGet(SUB_EWMH_WM_WINDOW_ROLE), NULL);
 
+  /* Intern instance and class, many windows share them but roles
+   * are often unique and quarks are never freed */
+  c->instance = ClientIntern(c->instance);
+  c->klass    = ClientIntern(c->klass);
+
   /* X properties */
   sattrs.border_pixel = subtle->styles.clients.bg; ///< Inactive
   sattrs.event_mask   = CLIENTMASK;
@@ -500,22 +574,15 @@ subClientFocus(SubClient *c,
   /* Remove urgent after getting focus */
   if(c->flags & SUB_CLIENT_MODE_URGENT)
     {
-      c->flags            &= ~SUB_CLIENT_MODE_URGENT;
-      subtle->urgent_tags &= ~c->tags;
+      c->flags &= ~SUB_CLIENT_MODE_URGENT;
+      subSharedTagsAndNot(&subtle->urgent_tags, &c->tags);
     }
 
   /* Unset current focus */
-  if((focus = CLIENT(subSubtleFind(subtle->windows.focus[0], CLIENTID))))
+  if((focus = CLIENT(subSubtleFind(subtle->windows.focus, CLIENTID))))
     {
-      int i;
-
       subGrabUnset(focus->win);
 
-      /* Reorder focus history */
-      for(i = (HISTORYSIZE - 1); 0 < i; i--)
-        subtle->windows.focus[i] = subtle->windows.focus[i - 1];
-      subtle->windows.focus[0] = 0;
-
       /* Exclude desktop type windows */
       if(!(focus->flags & SUB_CLIENT_TYPE_DESKTOP))
         XSetWindowBorder(subtle->dpy, focus->win, subtle->styles.clients.bg);
@@ -530,20 +597,35 @@ subClientFocus(SubClient *c,
   else if(c->flags & SUB_CLIENT_INPUT)
     XSetInputFocus(subtle->dpy, c->win, RevertToPointerRoot, CurrentTime);
 
-  /* Update focus */
-  subtle->windows.focus[0] = c->win;
+  /* Update focus and move client to front of both histories */
+  subtle->windows.focus = c->win;
   subGrabSet(c->win, SUB_GRAB_MOUSE);
 
+  s = SCREEN(subArrayGet(subtle->screens, c->screenid));
+
+  if(subtle->recent != c || (s && s->focus != c))
+    {
+      ClientRecentUnlink(c);
+
+      if((c->next = subtle->recent)) c->next->prev = c;
+      subtle->recent = c;
+      subtle->nrecent++;
+
+      if(s)
+        {
+          if((c->snext = s->focus)) c->snext->sprev = c;
+          s->focus = c;
+        }
+    }
+
   /* Exclude desktop and dock type windows */
   if(!(c->flags & (SUB_CLIENT_TYPE_DESKTOP|SUB_CLIENT_TYPE_DOCK)))
     XSetWindowBorder(subtle->dpy, c->win, subtle->styles.clients.fg);
 
-  /* EWMH: Active window */
-  subEwmhSetWindows(ROOT, SUB_EWMH_NET_ACTIVE_WINDOW,
-    subtle->windows.focus, HISTORYSIZE);
+  ClientRecentPublish();
 
   /* EWMH: Current desktop */
-  if((s = SCREEN(subArrayGet(subtle->screens, c->screenid))))
+  if(s)
     {
       subEwmhSetCardinals(ROOT, SUB_EWMH_NET_CURRENT_DESKTOP,
         (long *)&s->viewid, 1);
@@ -578,31 +660,38 @@ subClientNext(int screenid,
 {
   int i;
   SubClient *c = NULL;
+  SubScreen *s = SCREEN(subArrayGet(subtle->screens, screenid));
 
   /* Pass 1: Check focus history of current screen */
-  for(i = 1; i < HISTORYSIZE; i++)
+  for(c = s ? s->focus : NULL; c; c = c->snext)
     {
-      if((c = CLIENT(subSubtleFind(subtle->windows.focus[i], CLIENTID))))
-        {
-          /* Check visibility on current screen */
-          if(c->screenid == screenid && ALIVE(c) && VISIBLE(c) &&
-              c->win != subtle->windows.focus[0])
-            return c;
-        }
+      /* Skip clients that moved to another screen */
+      if(c->screenid == screenid && ALIVE(c) && VISIBLE(c) &&
+          c->win != subtle->windows.focus)
+        return c;
+    }
+
+  /* Pass 2: Check global focus history for clients that moved here */
+  for(c = subtle->recent; c; c = c->next)
+    {
+      /* Check visibility on current screen */
+      if(c->screenid == screenid && ALIVE(c) && VISIBLE(c) &&
+          c->win != subtle->windows.focus)
+        return c;
     }
 
-  /* Pass 2: Check client stacking list backwards of current screen */
+  /* Pass 3: Check client stacking list backwards of current screen */
   for(i = subtle->clients->ndata - 1; 0 <= i; i--)
     {
       c = CLIENT(subtle->clients->data[i]);
 
       /* Check visibility on current screen */
       if(c->screenid == screenid && ALIVE(c) && VISIBLE(c) &&
-          c->win != subtle->windows.focus[0])
+          c->win != subtle->windows.focus)
         return c;
     }
 
-  /* Pass 3: Check client stacking list backwards of any visible screen */
+  /* Pass 4: Check client stacking list backwards of any visible screen */
   if(1 < subtle->screens->ndata && jump)
     {
       for(i = subtle->clients->ndata - 1; 0 <= i; i--)
@@ -611,7 +700,7 @@ subClientNext(int screenid,
 
           /* Check visibility on current screen */
           if(ALIVE(c) && VISIBLE(c) &&
-              c->win != subtle->windows.focus[0])
+              c->win != subtle->windows.focus)
             return c;
         }
     }
@@ -783,6 +872,9 @@ subClientDrag(SubClient *c,
                             geom.x = (rx - wx) - (rx - ev.xmotion.x_root);
                             geom.y = (ry - wy) - (ry - ev.xmotion.y_root);
 
+                            /* Snap to neighbor edges, screen borders win */
+                            if(subtle->flags & SUB_SUBTLE_CLIENT_SNAP)
+                              subIndexSnap(c, s, &geom);
                             ClientSnap(c, s, &geom);
                             break; /* }}} */
                           case SUB_DRAG_RESIZE: /* {{{ */
@@ -834,6 +926,7 @@ subClientDrag(SubClient *c,
 
   XMoveResizeWindow(subtle->dpy, c->win, c->geom.x, c->geom.y,
     c->geom.width, c->geom.height);
+  subIndexDirty(c->screenid);
 
   /* Remove grabs */
   XUngrabPointer(subtle->dpy, CurrentTime);
@@ -865,7 +958,7 @@ subClientTag(SubClient *c,
 
       /* Collect flags and tags */
       *flags  |= (t->flags & (TYPES_ALL|MODES_ALL));
-      c->tags |= (1L << (tag + 1));
+      subSharedTagsSet(&c->tags, tag);
 
       /* Set size/position and enable float */
       if(t->flags & (SUB_TAG_GEOMETRY|SUB_TAG_POSITION))
@@ -885,6 +978,9 @@ subClientTag(SubClient *c,
       /* Set screen */
       if(t->flags & SUB_CLIENT_MODE_STICK && -1 != t->screenid)
         {
+          subIndexDirty(c->screenid); ///< Old and new screen
+          subIndexDirty(t->screenid);
+
           c->flags    |= SUB_CLIENT_MODE_STICK_SCREEN;
           c->screenid  = t->screenid;
         }
@@ -895,7 +991,8 @@ subClientTag(SubClient *c,
           SubView *v = VIEW(subtle->views->data[i]);
 
           /* Match views with this tag or sticky only */
-          if(v->tags & (1L << (tag + 1)) || t->flags & SUB_CLIENT_MODE_STICK)
+          if(subSharedTagsTest(&v->tags, tag) ||
+              t->flags & SUB_CLIENT_MODE_STICK)
             if(t->flags & SUB_TAG_GRAVITY) c->gravities[i] = t->gravityid;
         }
 
@@ -916,18 +1013,23 @@ subClientRetag(SubClient *c,
   int *flags)
 {
   int i;
+  TAGS tags;
 
   DEAD(c);
   assert(c);
 
-  c->tags = 0; ///< Reset tags
+  subSharedTagsClear(&c->tags); ///< Reset tags
 
   /* Check matching tags */
-  for(i = 0; i < subtle->tags->ndata; i++)
+  tags = subTagMatcherTags(c);
+
+  for(i = 0; !subSharedTagsEmpty(&tags) && i < subtle->tags->ndata; i++)
     {
-      /* Check if tag matches client */
-      if(subTagMatcherCheck(TAG(subtle->tags->data[i]), c))
-        subClientTag(c, i, flags);
+      if(subSharedTagsTest(&tags, i))
+        {
+          subClientTag(c, i, flags);
+          subSharedTagsUnset(&tags, i);
+        }
     }
 
   /* Check if client is visible on at least one screen w/o stick */
@@ -937,7 +1039,7 @@ subClientRetag(SubClient *c,
 
       for(i = 0; i < subtle->views->ndata; i++)
         {
-          if(VIEW(subtle->views->data[i])->tags & c->tags)
+          if(subSharedTagsAny(&VIEW(subtle->views->data[i])->tags, &c->tags))
             {
               visible++;
               break;
@@ -948,7 +1050,7 @@ subClientRetag(SubClient *c,
     }
 
   /* EWMH: Tags */
-  subEwmhSetCardinals(c->win, SUB_EWMH_SUBTLE_CLIENT_TAGS, (long *)&c->tags, 1);
+  subEwmhSetTags(c->win, SUB_EWMH_SUBTLE_CLIENT_TAGS, &c->tags);
 } /* }}} */
 
  /** subClientResize {{{
@@ -966,6 +1068,8 @@ subClientResize(SubClient *c,
   DEAD(c);
   assert(c);
 
+  subIndexDirty(c->screenid);
+
   /* Honor size hints */
   if(size_hints) ClientBounds(c, bounds, &c->geom, False, False);
 
@@ -1042,6 +1146,9 @@ subClientArrange(SubClient *c,
   DEAD(c);
   assert(c && s);
 
+  subIndexDirty(c->screenid); ///< Old and new screen
+  subIndexDirty(screenid);
+
   /* Check flags */
   if(c->flags & SUB_CLIENT_MODE_FULL)
     {
@@ -1118,7 +1225,15 @@ subClientArrange(SubClient *c,
               (old_g && old_g->flags & (SUB_GRAVITY_HORZ|SUB_GRAVITY_VERT))))
             ClientTile(old_gravity, old_screen);
 
-          if(subtle->flags & SUB_SUBTLE_TILING ||
+          if(VIEW(subtle->views->data[s->viewid])->flags & SUB_VIEW_LAYOUT)
+            {
+              /* Leave old screen in proper layout too */
+              if(-1 != old_screen && old_screen != c->screenid)
+                subClientLayout(old_screen);
+
+              subClientLayout(c->screenid);
+            }
+          else if(subtle->flags & SUB_SUBTLE_TILING ||
               (g && g->flags & (SUB_GRAVITY_HORZ|SUB_GRAVITY_VERT)))
             {
               ClientTile(gravityid, -1 == screenid ? 0 : screenid);
@@ -1177,7 +1292,7 @@ subClientToggle(SubClient *c,
         {
           /* Update highlight urgent client */
           if(c->flags & SUB_CLIENT_MODE_URGENT)
-            subtle->urgent_tags &= ~c->tags;
+            subSharedTagsAndNot(&subtle->urgent_tags, &c->tags);
         }
       else
         {
@@ -1192,7 +1307,8 @@ subClientToggle(SubClient *c,
                   SubView *v = VIEW(subtle->views->data[i]);
 
                   /* Check visibility manually */
-                  if(!(v->tags & c->tags) && -1 != c->gravityid)
+                  if(!subSharedTagsAny(&v->tags, &c->tags) &&
+                      -1 != c->gravityid)
                     c->gravities[i] = c->gravityid;
                 }
             }
@@ -1200,12 +1316,16 @@ subClientToggle(SubClient *c,
           /* Set screen when required*/
           if(!(c->flags & SUB_CLIENT_MODE_STICK_SCREEN))
             {
+              subIndexDirty(c->screenid);
+
               /* Find screen: Prefer screen of current window */
               if(subtle->flags & SUB_SUBTLE_SKIP_WARP &&
-                  (focus = CLIENT(subSubtleFind(subtle->windows.focus[0],
+                  (focus = CLIENT(subSubtleFind(subtle->windows.focus,
                   CLIENTID))) && VISIBLE(focus))
                 c->screenid = focus->screenid;
               else subScreenCurrent(&c->screenid);
+
+              subIndexDirty(c->screenid);
             }
       }
   }
@@ -1253,7 +1373,7 @@ subClientToggle(SubClient *c,
 
   /* Handle urgent mode */
   if(flags & SUB_CLIENT_MODE_URGENT)
-    subtle->urgent_tags |= c->tags;
+    subSharedTagsOr(&subtle->urgent_tags, &c->tags);
 
   /* Handle center mode */
   if(flags & SUB_CLIENT_MODE_CENTER)
@@ -1555,7 +1675,7 @@ subClientSetWMHints(SubClient *c,
       /* Handle urgency hint:
        * Set urgency if window hasn't focus and and
        * remove it after getting focus */
-      if(hints->flags & XUrgencyHint && c->win != subtle->windows.focus[0])
+      if(hints->flags & XUrgencyHint && c->win != subtle->windows.focus)
         {
           *flags |= SUB_CLIENT_MODE_URGENT;
         }
@@ -1569,8 +1689,9 @@ subClientSetWMHints(SubClient *c,
           if((k = CLIENT(subSubtleFind(hints->window_group, CLIENTID))))
             {
               *flags      |= (k->flags & MODES_ALL);
-              c->tags     |= k->tags;
               c->screenid |= k->screenid;
+
+              subSharedTagsOr(&c->tags, &k->tags);
             }
         }
 
@@ -1672,8 +1793,9 @@ subClientSetTransient(SubClient *c,
       if((k = CLIENT(subSubtleFind(trans, CLIENTID))))
         {
           *flags      |= (k->flags & MODES_ALL);
-          c->tags     |= k->tags;
           c->screenid |= k->screenid;
+
+          subSharedTagsOr(&c->tags, &k->tags);
         }
      }
 
@@ -1757,7 +1879,7 @@ subClientClose(SubClient *c)
     }
   else
     {
-      int sid = (subtle->windows.focus[0] == c->win ? c->screenid : -1); ///< Save
+      int sid = (subtle->windows.focus == c->win ? c->screenid : -1); ///< Save
 
       /* Kill it manually */
       XKillClient(subtle->dpy, c->win);
@@ -1795,6 +1917,7 @@ subClientKill(SubClient *c)
   /* Hook: Kill */
   subHookCall((SUB_HOOK_TYPE_CLIENT|SUB_HOOK_ACTION_KILL),
     (void *)c);
+  subRubyProxyKill(c->win);
 
   /* Remove _NET_WM_STATE (see EWMH 1.3) */
   subSharedPropertyDelete(subtle->dpy, c->win,
@@ -1806,7 +1929,15 @@ subClientKill(SubClient *c)
 
   /* Remove client tags from urgent tags */
   if(c->flags & SUB_CLIENT_MODE_URGENT)
-    subtle->urgent_tags &= ~c->tags;
+    subSharedTagsAndNot(&subtle->urgent_tags, &c->tags);
+
+  /* Remove client from focus history and index */
+  if(ClientRecentUnlink(c)) ClientRecentPublish();
+  subIndexDirty(-1); ///< Stacking positions shift
+
+  /* Remember window for next tile hook */
+  if(-2 != c->tilescreenid && subtle->removed)
+    subArrayPush(subtle->removed, (void *)c->win);
 
   /* Tile remaining clients if necessary */
   if(VISIBLE(c))
@@ -1820,16 +1951,150 @@ subClientKill(SubClient *c)
 
   if(c->gravities) free(c->gravities);
   if(c->name)      free(c->name);
-  if(c->instance)  free(c->instance);
-  if(c->klass)     free(c->klass);
   if(c->role)      free(c->role);
-  free(c);
+  subPoolFree(subtle->pools.clients, c);
 
   subSubtleLogDebugSubtle("Kill\n");
 } /* }}} */
 
 /* All */
 
+ /** subClientLayout {{{
+  * @brief Arrange all tiled clients of a screen with the layout of its view
+  * @param[in]  screenid  Screen id
+  * @retval  True   View has a layout
+  * @retval  False  View has no layout
+  **/
+
+int
+subClientLayout(int screenid)
+{
+  int i, n = 0;
+  SubScreen *s = SCREEN(subArrayGet(subtle->screens, screenid));
+  SubView *v = NULL;
+  SubClient **clients = NULL;
+  XRectangle *rects = NULL;
+
+  /* Check whether view has a layout */
+  if(!s || !(v = VIEW(subArrayGet(subtle->views, s->viewid))) ||
+      !(v->flags & SUB_VIEW_LAYOUT))
+    return False;
+
+  if(0 == subtle->clients->ndata) return True;
+
+  clients = (SubClient **)subSharedMemoryAlloc(subtle->clients->ndata,
+    sizeof(SubClient *));
+
+  /* Collect tiled clients of screen */
+  for(i = 0; i < subtle->clients->ndata; i++)
+    {
+      SubClient *c = CLIENT(subtle->clients->data[i]);
+
+      if(ALIVE(c) && c->screenid == screenid &&
+          VISIBLETAGS(c, v->tags) && !(c->flags & LAYOUTMASK))
+        clients[n++] = c;
+    }
+
+  /* Calculate all geometries at once and apply them in one batch */
+  if(0 < n)
+    {
+      rects = (XRectangle *)subSharedMemoryAlloc(n, sizeof(XRectangle));
+
+      subLayoutGeometry(v, &(s->geom), rects, n);
+
+      for(i = 0; i < n; i++)
+        {
+          clients[i]->geom = rects[i];
+
+          ClientResize(clients[i], &(s->geom));
+        }
+
+      free(rects);
+    }
+
+  free(clients);
+
+  return True;
+} /* }}} */
+
+ /** subClientRetagLive {{{
+  * @brief Update live tags of clients whose names changed and configure
+  *        once if any tags changed
+  **/
+
+void
+subClientRetagLive(void)
+{
+  int i, changed = 0;
+  TAGS live = subTagMatcherLive();
+
+  subtle->flags &= ~SUB_SUBTLE_RETAG;
+
+  for(i = 0; i < subtle->clients->ndata; i++)
+    {
+      SubClient *c = CLIENT(subtle->clients->data[i]);
+      TAGS tags, current;
+
+      if(!c->retag || !ALIVE(c)) continue;
+
+      c->retag = False;
+
+      /* Just name matchers run here, the rest is cached */
+      tags    = subTagMatcherTags(c);
+      current = c->tags;
+
+      subSharedTagsAnd(&tags, &live);
+      subSharedTagsAnd(&current, &live);
+
+      if(!subSharedTagsEqual(&tags, &current))
+        {
+          int j, flags = 0, visible = VISIBLE(c);
+          TAGS added = tags;
+
+          /* Only touch live tags and keep all others */
+          subSharedTagsAndNot(&added, &current);
+          subSharedTagsAndNot(&current, &tags);
+          subSharedTagsAndNot(&c->tags, &current); ///< Remove stale tags
+
+          for(j = 0; !subSharedTagsEmpty(&added) &&
+              j < subtle->tags->ndata; j++)
+            {
+              if(subSharedTagsTest(&added, j))
+                {
+                  subClientTag(c, j, &flags);
+                  subSharedTagsUnset(&added, j);
+                }
+            }
+
+          /* Fall back to default tag when no view shows the client */
+          if(!(c->flags & SUB_CLIENT_MODE_STICK) &&
+              !(flags & SUB_CLIENT_MODE_STICK))
+            {
+              for(j = 0; j < subtle->views->ndata; j++)
+                if(subSharedTagsAny(&VIEW(subtle->views->data[j])->tags,
+                    &c->tags)) break;
+
+              if(j == subtle->views->ndata) subClientTag(c, 0, &flags);
+            }
+
+          /* EWMH: Tags */
+          subEwmhSetTags(c->win, SUB_EWMH_SUBTLE_CLIENT_TAGS, &c->tags);
+
+          subClientToggle(c, (~c->flags & flags), True); ///< Toggle flags
+
+          if(visible || VISIBLE(c) || flags & SUB_CLIENT_MODE_FULL)
+            changed++;
+        }
+    }
+
+  if(0 < changed)
+    {
+      subScreenConfigure();
+      subScreenUpdate();
+      subScreenRender();
+    }
+} /* }}} */
+
  /** subClientPublish {{{
   * @brief Publish clients
   * @param[in]  restack  Restack windows
@@ -1858,9 +2123,35 @@ subClientPublish(int restack)
   XSync(subtle->dpy, False); ///< Sync all changes
 
   free(wins);
+  subIndexDirty(-1); ///< Stacking order may have changed
 
   subSubtleLogDebugSubtle("Publish: clients=%d, restack=%d\n",
     subtle->clients->ndata, restack);
 } /* }}} */
 
+
+ /** subClientPublishHistory {{{
+  * @brief Publish focus history
+  **/
+
+void
+subClientPublishHistory(void)
+{
+  int i;
+  SubClient *c = NULL;
+  Window *wins = (Window *)subSharedMemoryAlloc(MAX(1, subtle->nrecent),
+    sizeof(Window));
+
+  for(i = 0, c = subtle->recent; c; c = c->next)
+    wins[i++] = c->win;
+
+  /* EWMH: Focus history, most recent first */
+  subEwmhSetWindows(ROOT, SUB_EWMH_SUBTLE_FOCUS_HISTORY, wins, i);
+
+  free(wins);
+  subtle->flags &= ~SUB_SUBTLE_HISTORY;
+
+  subSubtleLogDebugSubtle("PublishHistory: clients=%d\n", i);
+} /* }}} */
+
 // vim:ts=2:bs=2:sw=2:et:fdm=marker
@@ -282,6 +282,7 @@ subDisplayScan(void)
 
   /* Scan for client windows */
   XQueryTree(subtle->dpy, ROOT, &wroot, &parent, &wins, &nwins);
+  subArrayReserve(subtle->clients, subtle->clients->ndata + nwins);
 
   for(i = 0; i < nwins; i++)
     {
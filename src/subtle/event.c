@@ -11,12 +11,13 @@
   **/
 
 #include <unistd.h>
+#include <limits.h>
 #include <X11/Xatom.h>
 #include <sys/poll.h>
 #include "subtle.h"
 
 #ifdef HAVE_SYS_INOTIFY_H
-#define BUFLEN (sizeof(struct inotify_event))
+#define BUFLEN (sizeof(struct inotify_event) + NAME_MAX + 1)
 #endif /* HAVE_SYS_INOTIFY_H */
 
 #ifdef HAVE_X11_EXTENSIONS_XRANDR_H
@@ -25,33 +26,49 @@
 
 /* Globals */
 struct pollfd *watches = NULL;
-XClientMessageEvent *queue = NULL;
-int nwatches = 0, nqueue = 0;
+XClientMessageEvent *queue = NULL, *pending = NULL;
+int nwatches = 0, nqueue = 0, npending = 0;
 
 /* EventUntag {{{ */
 static void
 EventUntag(SubClient *c,
   int id)
 {
-  int i, tag;
-
   /* Shift bits */
-  for(i = id; i < subtle->tags->ndata - 1; i++)
-    {
-      tag = (1L << (i + 1));
-
-      if(c->tags & (1L << (i + 2))) ///< Next bit
-        c->tags |= tag;
-      else
-        c->tags &= ~tag;
-    }
+  subSharedTagsRemove(&c->tags, id);
 
   /* EWMH: Tags */
   if(c->flags & SUB_TYPE_CLIENT)
+    subEwmhSetTags(c->win, SUB_EWMH_SUBTLE_CLIENT_TAGS, &c->tags);
+} /* }}} */
+
+/* EventTagsFetch {{{ */
+static int
+EventTagsFetch(XClientMessageEvent *ev,
+  SubTags *tags)
+{
+  int ret = False;
+  unsigned long size = 0;
+  long *cards = NULL;
+
+  /* Tags are stored as id and cardinals in the property named by the
+   * message, all of them are applied at once */
+  if((cards = (long *)subSharedPropertyGet(subtle->dpy,
+      (Window)ev->data.l[1], XA_CARDINAL, (Atom)ev->data.l[2], &size)))
     {
-      subEwmhSetCardinals(c->win, SUB_EWMH_SUBTLE_CLIENT_TAGS,
-        (long *)&c->tags, 1);
+      if(1 < size && cards[0] == ev->data.l[0])
+        {
+          subSharedTagsFromCards(tags, cards + 1, size - 1);
+          subSharedPropertyDelete(subtle->dpy, (Window)ev->data.l[1],
+            (Atom)ev->data.l[2]);
+
+          ret = True;
+        }
+
+      XFree(cards);
     }
+
+  return ret;
 } /* }}} */
 
 /* EventFindSublet {{{ */
@@ -78,6 +95,39 @@ EventFindSublet(int id)
   return NULL;
 } /* }}} */
 
+/* EventSameDisplay {{{ */
+static int
+EventSameDisplay(Display *disp)
+{
+  /* Only handle requests for the display we manage */
+  return disp && (disp == subtle->dpy ||
+    0 == strcmp(DisplayString(disp), DisplayString(subtle->dpy)));
+} /* }}} */
+
+/* EventDirectSafe {{{ */
+static int
+EventDirectSafe(XClientMessageEvent *ev)
+{
+  /* Messages that only change existing objects */
+  switch(subEwmhFind(ev->message_type))
+    {
+      case SUB_EWMH_NET_CURRENT_DESKTOP:
+      case SUB_EWMH_NET_ACTIVE_WINDOW:
+      case SUB_EWMH_NET_RESTACK_WINDOW:
+      case SUB_EWMH_NET_MOVERESIZE_WINDOW:
+      case SUB_EWMH_NET_WM_STATE:
+      case SUB_EWMH_SUBTLE_CLIENT_TAGS:
+      case SUB_EWMH_SUBTLE_CLIENT_RETAG:
+      case SUB_EWMH_SUBTLE_CLIENT_GRAVITY:
+      case SUB_EWMH_SUBTLE_CLIENT_FLAGS:
+      case SUB_EWMH_SUBTLE_SCREEN_JUMP:
+        return True;
+      default: break;
+    }
+
+  return False;
+} /* }}} */
+
 /* EventQueuePush {{{ */
 static void
 EventQueuePush(XClientMessageEvent *ev,
@@ -133,55 +183,6 @@ EventQueuePop(long value,
     }
 } /* }}} */
 
-/* EventMatch {{{ */
-static int
-EventMatch(int type,
-  XRectangle *origin,
-  XRectangle *test)
-{
-  int cx_origin = 0, cx_test = 0, cy_origin = 0, cy_test = 0, dx = 0, dy = 0;
-
-  /* This check is complicated and consists of three parts:
-   * 1) Calculate window center positions
-   * 2) Check if x/y values decrease in given direction
-   * 3) Check if a corner of one of the rects is close enough to
-   *    a side of the other rect */
-
-  /* Calculate window centers */
-  cx_origin = origin->x + (origin->width / 2);
-  cx_test   = test->x + (test->width / 2);
-
-  cy_origin = origin->y + (origin->height / 2);
-  cy_test   = test->y + (test->height / 2);
-
-  /* Check geometries */
-  if((((SUB_GRAB_DIRECTION_LEFT  == type      && cx_test   <= cx_origin)                  ||
-       (SUB_GRAB_DIRECTION_RIGHT == type      && cx_test   >= cx_origin))                 &&
-       ((cy_test                 >= origin->y && cy_test   <= origin->y + origin->height) ||
-       (cy_origin                >= test->y   && cy_origin <= test->y   + test->height))) ||
-
-     (((SUB_GRAB_DIRECTION_UP    == type      && cy_test   <= cy_origin)                  ||
-       (SUB_GRAB_DIRECTION_DOWN  == type      && cy_test   >= cy_origin))                 &&
-       ((cx_test                 >= origin->x && cx_test   <= origin->x + origin->width)  ||
-       (cx_origin                 >= test->x   && cx_origin <= test->x   + test->width))))
-    {
-      /* Euclidean distance */
-      dx = abs(cx_origin - cx_test);
-      dy = abs(cy_origin - cy_test);
-
-      /* Zero distance means same dimensions - highest distance */
-      if(0 == dx && 0 == dy) dx = dy = 1L << 15;
-    }
-  else
-    {
-      /* No match - highest distance too */
-      dx = 1L << 15;
-      dy = 1L << 15;
-    }
-
-  return dx + dy;
-} /* }}} */
-
 /* Events */
 
 /* EventColormap {{{ */
@@ -344,7 +345,7 @@ EventDestroy(XDestroyWindowEvent *ev)
   /* Check if we know this window */
   if((c = CLIENT(subSubtleFind(ev->window, CLIENTID)))) ///< Client
     {
-      int sid = (subtle->windows.focus[0] == c->win ? c->screenid : -1); ///< Save
+      int sid = (subtle->windows.focus == c->win ? c->screenid : -1); ///< Save
 
       /* Kill client */
       subArrayRemove(subtle->clients, (void *)c);
@@ -360,7 +361,7 @@ EventDestroy(XDestroyWindowEvent *ev)
     }
   else if((t = TRAY(subSubtleFind(ev->event, TRAYID)))) ///< Tray
     {
-      int focus = (subtle->windows.focus[0] == ev->window); ///< Save
+      int focus = (subtle->windows.focus == ev->window); ///< Save
 
       /* Kill tray */
       subArrayRemove(subtle->trays, (void *)t);
@@ -405,7 +406,7 @@ static void
 EventFocus(XFocusChangeEvent *ev)
 {
   /* Check window has focus or focus is caused by grabs */
-  if(ev->window == subtle->windows.focus[0] ||
+  if(ev->window == subtle->windows.focus ||
     NotifyGrab == ev->mode || NotifyUngrab == ev->mode) return;
 
   subSubtleLogDebugEvents("Focus: win=%#lx, mode=%d\n", ev->window, ev->mode);
@@ -576,12 +577,12 @@ EventGrab(XEvent *ev)
             break; /* }}} */
           case SUB_GRAB_PROC: /* {{{ */
             subRubyCall(SUB_CALL_HOOKS, g->data.num,
-              subSubtleFind(subtle->windows.focus[0], CLIENTID));
+              subSubtleFind(subtle->windows.focus, CLIENTID));
             break; /* }}} */
           case SUB_GRAB_WINDOW_MOVE:
           case SUB_GRAB_WINDOW_RESIZE: /* {{{ */
             /* Prevent resize of fixed and move/resize of fullscreen windows */
-            if((c = CLIENT(subSubtleFind(subtle->windows.focus[0], CLIENTID))) &&
+            if((c = CLIENT(subSubtleFind(subtle->windows.focus, CLIENTID))) &&
                 !(c->flags & SUB_CLIENT_MODE_FULL) &&
                 !(SUB_GRAB_WINDOW_RESIZE == flag &&
                   c->flags & SUB_CLIENT_MODE_FIXED))
@@ -602,7 +603,7 @@ EventGrab(XEvent *ev)
               }
             break; /* }}} */
           case SUB_GRAB_WINDOW_TOGGLE: /* {{{ */
-            if((c = CLIENT(subSubtleFind(subtle->windows.focus[0], CLIENTID))))
+            if((c = CLIENT(subSubtleFind(subtle->windows.focus, CLIENTID))))
               {
                 subClientToggle(c, g->data.num, True);
 
@@ -622,7 +623,7 @@ EventGrab(XEvent *ev)
               }
             break; /* }}} */
           case SUB_GRAB_WINDOW_STACK: /* {{{ */
-            if((c = CLIENT(subSubtleFind(subtle->windows.focus[0], CLIENTID))) &&
+            if((c = CLIENT(subSubtleFind(subtle->windows.focus, CLIENTID))) &&
                 !(c->flags & SUB_CLIENT_TYPE_DESKTOP) &&
                 VISIBLE(c))
               subClientRestack(c, g->data.num);
@@ -632,50 +633,16 @@ EventGrab(XEvent *ev)
               SubClient *found = NULL;
 
               /* Check if a window is currently focussed or just select next*/
-              if((c = CLIENT(subSubtleFind(subtle->windows.focus[0],
+              if((c = CLIENT(subSubtleFind(subtle->windows.focus,
                   CLIENTID))))
-                {
-                  int i, j, match = (1L << 30), distance = 0;
-
-                  /* Iterate once to find a client with smallest distance */
-                  for(i = 0; i < subtle->clients->ndata; i++)
-                    {
-                      SubClient *k = CLIENT(subtle->clients->data[i]);
-
-                      /* Check if both clients are different and visible */
-                      if(c != k && (subtle->visible_tags & k->tags ||
-                          k->flags & SUB_CLIENT_MODE_STICK))
-                        {
-                          /* Substract stack position index to get top window */
-                          distance = EventMatch(g->data.num, &c->geom,
-                            &k->geom) - i;
+                found = subIndexSelect(c, g->data.num);
+              else found = subClientNext(-1, True);
 
-                          /* Substract history stack position index */
-                          for(j = 1; j < HISTORYSIZE; j++)
-                            {
-                              if(subtle->windows.focus[j] == k->win)
-                                {
-                                  distance -= (HISTORYSIZE - j);
-                                  break;
-                                }
-                            }
-
-                          /* Finally compare distance */
-                          if(match > distance)
-                            {
-                              match = distance;
-                              found = k;
-                            }
-                        }
-                    }
-                  }
-                else found = subClientNext(-1, True);
-
-                if(found) subClientFocus(found, True);
-              }
+              if(found) subClientFocus(found, True);
+            }
             break; /* }}} */
           case SUB_GRAB_WINDOW_GRAVITY: /* {{{ */
-            if((c = CLIENT(subSubtleFind(subtle->windows.focus[0], CLIENTID))) &&
+            if((c = CLIENT(subSubtleFind(subtle->windows.focus, CLIENTID))) &&
                 !(c->flags & SUB_CLIENT_MODE_FIXED))
               {
                 int i, id = -1, cid = 0, fid = (int)g->data.string[0] -
@@ -718,12 +685,12 @@ EventGrab(XEvent *ev)
                       subClientWarp(c);
 
                     /* Hook: Tile */
-                    subHookCall(SUB_HOOK_TILE, NULL);
+                    subScreenTile();
                   }
               }
             break; /* }}} */
           case SUB_GRAB_WINDOW_KILL: /* {{{ */
-            if((c = CLIENT(subSubtleFind(subtle->windows.focus[0], CLIENTID))))
+            if((c = CLIENT(subSubtleFind(subtle->windows.focus, CLIENTID))))
               subClientClose(c);
             break; /* }}} */
           case SUB_GRAB_VIEW_FOCUS:
@@ -734,7 +701,7 @@ EventGrab(XEvent *ev)
 
                 /* Find screen: Prefer screen of current window */
                 if(subtle->flags & SUB_SUBTLE_SKIP_WARP &&
-                    (c = CLIENT(subSubtleFind(subtle->windows.focus[0],
+                    (c = CLIENT(subSubtleFind(subtle->windows.focus,
                     CLIENTID))) && VISIBLE(c))
                   sid = c->screenid;
                 else subScreenFind(x, y, &sid);
@@ -750,7 +717,7 @@ EventGrab(XEvent *ev)
 
                 /* Find screen: Prefer screen of current window */
                 if(subtle->flags & SUB_SUBTLE_SKIP_WARP &&
-                    (c = CLIENT(subSubtleFind(subtle->windows.focus[0],
+                    (c = CLIENT(subSubtleFind(subtle->windows.focus,
                     CLIENTID))) && VISIBLE(c))
                   {
                     s   = SCREEN(subArrayGet(subtle->screens, c->screenid));
@@ -897,7 +864,7 @@ EventMessage(XClientMessageEvent *ev)
                   {
                     /* Find screen: Prefer screen of current window */
                     if(subtle->flags & SUB_SUBTLE_SKIP_WARP &&
-                        (c = CLIENT(subSubtleFind(subtle->windows.focus[0],
+                        (c = CLIENT(subSubtleFind(subtle->windows.focus,
                         CLIENTID))) && VISIBLE(c))
                       sid = c->screenid;
                     else subScreenCurrent(&sid);
@@ -918,7 +885,8 @@ EventMessage(XClientMessageEvent *ev)
                     /* Find matching view */
                     for(i = 0; i < subtle->views->ndata; i++)
                       {
-                        if(c && (VIEW(subtle->views->data[i])->tags & c->tags ||
+                        if(c && (subSharedTagsAny(
+                            &VIEW(subtle->views->data[i])->tags, &c->tags) ||
                             c->flags & SUB_CLIENT_MODE_STICK))
                           {
                             subViewFocus(VIEW(subtle->views->data[i]),
@@ -947,31 +915,36 @@ EventMessage(XClientMessageEvent *ev)
             /* Check if client is ready yet otherwise queue it */
             if((c = CLIENT(subSubtleFind(ev->data.l[0], CLIENTID))))
               {
-                int i, flags = 0, tags = 0;
+                int i, flags = 0;
+                TAGS tags, added;
+
+                /* Fetch tags from property */
+                if(!EventTagsFetch(ev, &tags)) break;
 
                 /* Select only new tags */
-                tags = (c->tags ^ (int)ev->data.l[1]) & (int)ev->data.l[1];
+                added = tags;
+                subSharedTagsAndNot(&added, &c->tags);
 
                 /* Remove highlight of tagless, urgent client */
-                if(0 == tags && c->flags & SUB_CLIENT_MODE_URGENT)
-                  subtle->urgent_tags &= ~c->tags;
+                if(subSharedTagsEmpty(&added) &&
+                    c->flags & SUB_CLIENT_MODE_URGENT)
+                  subSharedTagsAndNot(&subtle->urgent_tags, &c->tags);
 
                 /* Update tags and assign properties */
-                for(i = 0; i < 31; i++)
-                  if(tags & (1L << (i + 1))) subClientTag(c, i, &flags);
+                for(i = 0; i < subtle->tags->ndata; i++)
+                  if(subSharedTagsTest(&added, i)) subClientTag(c, i, &flags);
 
                 subClientToggle(c, flags, True); ///< Toggle flags
-                c->tags = (int)ev->data.l[1]; ///< Write all tags
+                c->tags = tags; ///< Write all tags
 
                 /* EWMH: Tags */
-                subEwmhSetCardinals(c->win, SUB_EWMH_SUBTLE_CLIENT_TAGS,
-                  (long *)&c->tags, 1);
+                subEwmhSetTags(c->win, SUB_EWMH_SUBTLE_CLIENT_TAGS, &c->tags);
 
                 subScreenConfigure();
 
                 /* Check visibility of focus window after updating tags
                  * and reactivate grabs if necessary */
-                if(subtle->windows.focus[0] == c->win &&
+                if(subtle->windows.focus == c->win &&
                     !VISIBLE(c))
                   {
                     c = subClientNext(c->screenid, False);
@@ -988,7 +961,7 @@ EventMessage(XClientMessageEvent *ev)
               {
                 int flags = 0;
 
-                c->tags = 0; ///> Reset tags
+                subSharedTagsClear(&c->tags); ///> Reset tags
 
                 subClientRetag(c, &flags);
                 subClientToggle(c, (~c->flags & flags), True); ///< Toggle flags
@@ -1014,7 +987,8 @@ EventMessage(XClientMessageEvent *ev)
                       {
                         c->gravities[(int)ev->data.l[2]] = (int)ev->data.l[1];
 
-                        if(subtle->visible_views & (1L << ((int)ev->data.l[2] + 1)))
+                        if(subSharedTagsTest(&subtle->visible_views,
+                            (int)ev->data.l[2]))
                           {
                           printf("DEBUG %s:%d\n", __FILE__, __LINE__);
                             subClientArrange(c,
@@ -1026,7 +1000,7 @@ EventMessage(XClientMessageEvent *ev)
                               subClientWarp(c);
 
                             /* Hook: Tile */
-                            subHookCall(SUB_HOOK_TILE, NULL);
+                            subScreenTile();
                           }
                       }
                     else if(VISIBLE(c))
@@ -1039,7 +1013,7 @@ EventMessage(XClientMessageEvent *ev)
                           subClientWarp(c);
 
                         /* Hook: Tile */
-                        subHookCall(SUB_HOOK_TILE, NULL);
+                        subScreenTile();
                       }
                   }
               }
@@ -1153,8 +1127,7 @@ EventMessage(XClientMessageEvent *ev)
                 p->sublet->flags & SUB_SUBLET_DATA)
               {
                 subRubyCall(SUB_CALL_DATA, p->sublet->instance, NULL);
-                subScreenUpdate();
-                subScreenRender();
+                subScreenSchedule();
               }
             break; /* }}} */
           case SUB_EWMH_SUBTLE_SUBLET_STYLE: /* {{{ */
@@ -1201,8 +1174,7 @@ EventMessage(XClientMessageEvent *ev)
             if((p = EventFindSublet((int)ev->data.l[0])))
               {
                 subRubyCall(SUB_CALL_RUN, p->sublet->instance, NULL);
-                subScreenUpdate();
-                subScreenRender();
+                subScreenSchedule();
               }
             break; /* }}} */
           case SUB_EWMH_SUBTLE_SUBLET_KILL: /* {{{ */
@@ -1214,7 +1186,7 @@ EventMessage(XClientMessageEvent *ev)
               }
             break; /* }}} */
           case SUB_EWMH_SUBTLE_TAG_NEW: /* {{{ */
-            if(ev->data.b)
+            if(ev->data.b && TAGSMAX > subtle->tags->ndata)
               {
                 int duplicate = False;
 
@@ -1237,10 +1209,12 @@ EventMessage(XClientMessageEvent *ev)
                 /* Untag views */
                 for(i = 0; i < subtle->views->ndata; i++) ///< Views
                   {
-                    v      = VIEW(subtle->views->data[i]);
-                    reconf = v->tags & (1L << ((int)ev->data.l[0] + 1));
+                    v = VIEW(subtle->views->data[i]);
 
-                    EventUntag(CLIENT(v), (int)ev->data.l[0]);
+                    if(subSharedTagsTest(&v->tags, (int)ev->data.l[0]))
+                      reconf = True;
+
+                    subSharedTagsRemove(&v->tags, (int)ev->data.l[0]);
                   }
 
                 /* Untag clients */
@@ -1277,12 +1251,14 @@ EventMessage(XClientMessageEvent *ev)
             if((v = VIEW(subArrayGet(subtle->views,
                 (int)ev->data.l[0]))))
               {
-                v->tags = (int)ev->data.l[1]; ///< Action
+                /* Fetch tags from property */
+                if(!EventTagsFetch(ev, &v->tags)) break;
 
                 subViewPublish();
 
                 /* Reconfigure if view is visible */
-                if(subtle->visible_views & (1L << (ev->data.l[0] + 1)))
+                if(subSharedTagsTest(&subtle->visible_views,
+                    (int)ev->data.l[0]))
                   subScreenConfigure();
               }
             else EventQueuePush(ev, SUB_TYPE_VIEW);
@@ -1310,7 +1286,8 @@ EventMessage(XClientMessageEvent *ev)
           case SUB_EWMH_SUBTLE_VIEW_KILL: /* {{{ */
             if((v = VIEW(subArrayGet(subtle->views, (int)ev->data.l[0]))))
               {
-                int visible = !!(subtle->visible_views & (1L << (ev->data.l[0] + 1)));
+                int visible = subSharedTagsTest(&subtle->visible_views,
+                  (int)ev->data.l[0]);
 
                 subArrayRemove(subtle->views, (void *)v);
                 subClientDimension((int)ev->data.l[0]); ///< Shrink
@@ -1493,10 +1470,24 @@ EventProperty(XPropertyEvent *ev)
       case SUB_EWMH_WM_NAME: /* {{{ */
         if((c = CLIENT(subSubtleFind(ev->window, CLIENTID))))
           {
+            TAGS live = subTagMatcherLive();
+
             if(c->name) free(c->name);
             subSharedPropertyName(subtle->dpy, c->win, &c->name, c->klass);
 
-            if(subtle->windows.focus[0] == c->win)
+            /* Debounce live retag */
+            if(!c->retag && !subSharedTagsEmpty(&live))
+              {
+                c->retag = True;
+
+                if(!(subtle->flags & SUB_SUBTLE_RETAG))
+                  {
+                    subtle->flags |= SUB_SUBTLE_RETAG;
+                    subtle->retag  = subSubtleTicks() + RETAGDELAY;
+                  }
+              }
+
+            if(subtle->windows.focus == c->win)
               {
                 subScreenUpdate();
                 subScreenRender();
@@ -1608,7 +1599,7 @@ EventUnmap(XUnmapEvent *ev)
   /* Check if we know this window */
   if((c = CLIENT(subSubtleFind(ev->window, CLIENTID))))
     {
-      int sid = (subtle->windows.focus[0] == c->win ? c->screenid : -1); ///< Save
+      int sid = (subtle->windows.focus == c->win ? c->screenid : -1); ///< Save
 
       /* Set withdrawn state (see ICCCM 4.1.4) */
       subEwmhSetWMState(c->win, WithdrawnState);
@@ -1635,7 +1626,7 @@ EventUnmap(XUnmapEvent *ev)
     }
   else if((t = TRAY(subSubtleFind(ev->window, TRAYID)))) ///< Tray
     {
-      int focus = (subtle->windows.focus[0] == ev->window); ///< Save
+      int focus = (subtle->windows.focus == ev->window); ///< Save
 
       /* Set withdrawn state (see ICCCM 4.1.4) */
       subEwmhSetWMState(t->win, WithdrawnState);
@@ -1708,6 +1699,164 @@ subEventWatchDel(int fd)
     nwatches * sizeof(struct pollfd));
 } /* }}} */
 
+ /** subEventDirectMessage {{{
+  * @brief Queue client message of subtlext inside of subtle
+  * @param[in]  disp  Display of the sender
+  * @param[in]  ev    A #XClientMessageEvent
+  * @retval  True   Message was queued
+  * @retval  False  Message must be sent via X
+  **/
+
+int
+subEventDirectMessage(Display *disp,
+  XClientMessageEvent *ev)
+{
+  if(!EventSameDisplay(disp)) return False;
+
+  /* Queue every message to keep the order subtlext sent them in */
+  pending = (XClientMessageEvent *)subSharedMemoryRealloc(pending,
+    (npending + 1) * sizeof(XClientMessageEvent));
+  pending[npending++] = *ev;
+
+  subSubtleLogDebugEvents("Direct: type=%ld, win=%#lx\n",
+    ev->message_type, ev->window);
+
+  return True;
+} /* }}} */
+
+ /** subEventDirectFlush {{{
+  * @brief Handle queued direct messages in order
+  * @param[in]  all  Also handle messages that create or kill objects
+  **/
+
+void
+subEventDirectFlush(int all)
+{
+  int i;
+  static int flushing = False;
+
+  /* Messages queued by handlers are picked up by the outer loop */
+  if(flushing || 0 == npending) return;
+
+  flushing = True;
+
+  for(i = 0; i < npending; i++)
+    {
+      XClientMessageEvent ev = pending[i]; ///< Array may grow
+
+      /* Callers of ruby may still hold objects, stop at first message
+       * that can free them and leave the rest to the event loop */
+      if(!all && !EventDirectSafe(&ev)) break;
+
+      EventMessage(&ev);
+    }
+
+  /* Keep order of leftovers */
+  if(i < npending)
+    memmove(pending, pending + i,
+      (npending - i) * sizeof(XClientMessageEvent));
+
+  npending -= i;
+  flushing = False;
+} /* }}} */
+
+ /** subEventDirectProperty {{{
+  * @brief Get property for subtlext from live values
+  * @param[in]   disp  Display of the caller
+  * @param[in]   win   Window
+  * @param[in]   type  Property type
+  * @param[in]   prop  Property atom
+  * @param[out]  size  Number of items
+  * @return Returns property data or \p NULL
+  **/
+
+char *
+subEventDirectProperty(Display *disp,
+  Window win,
+  Atom type,
+  Atom prop,
+  unsigned long *size)
+{
+  int i, n = 0;
+  long *data = NULL;
+  SubClient *c = NULL;
+
+  if(!EventSameDisplay(disp)) return NULL;
+
+  if(ROOT == win)
+    {
+      switch(subEwmhFind(prop))
+        {
+          case SUB_EWMH_NET_ACTIVE_WINDOW: /* {{{ */
+            if(XA_WINDOW == type && subtle->recent)
+              {
+                data    = (long *)subSharedMemoryAlloc((n = 1), sizeof(long));
+                data[0] = subtle->recent->win;
+              }
+            break; /* }}} */
+          case SUB_EWMH_SUBTLE_FOCUS_HISTORY: /* {{{ */
+            if(XA_WINDOW == type && 0 < (n = subtle->nrecent))
+              {
+                data = (long *)subSharedMemoryAlloc(n, sizeof(long));
+
+                /* Focus history, most recent first */
+                for(i = 0, c = subtle->recent; c && i < n; c = c->next)
+                  data[i++] = c->win;
+              }
+            break; /* }}} */
+          case SUB_EWMH_NET_CLIENT_LIST: /* {{{ */
+            if(XA_WINDOW == type && 0 < (n = subtle->clients->ndata))
+              {
+                data = (long *)subSharedMemoryAlloc(n, sizeof(long));
+
+                /* Same order as published list */
+                for(i = 0; i < n; i++)
+                  data[n - 1 - i] = CLIENT(subtle->clients->data[i])->win;
+              }
+            break; /* }}} */
+          case SUB_EWMH_SUBTLE_VISIBLE_TAGS: /* {{{ */
+            if(XA_CARDINAL == type)
+              {
+                data = (long *)subSharedMemoryAlloc(TAGSCARDS, sizeof(long));
+                n    = subSharedTagsToCards(&subtle->visible_tags, data);
+              }
+            break; /* }}} */
+          case SUB_EWMH_SUBTLE_VISIBLE_VIEWS: /* {{{ */
+            if(XA_CARDINAL == type)
+              {
+                data = (long *)subSharedMemoryAlloc(TAGSCARDS, sizeof(long));
+                n    = subSharedTagsToCards(&subtle->visible_views, data);
+              }
+            break; /* }}} */
+          default: break;
+        }
+    }
+  else if(XA_CARDINAL == type &&
+      (c = CLIENT(subSubtleFind(win, CLIENTID))))
+    {
+      switch(subEwmhFind(prop))
+        {
+          case SUB_EWMH_SUBTLE_CLIENT_TAGS:
+            data = (long *)subSharedMemoryAlloc(TAGSCARDS, sizeof(long));
+            n    = subSharedTagsToCards(&c->tags, data);
+            break;
+          case SUB_EWMH_SUBTLE_CLIENT_GRAVITY:
+            data    = (long *)subSharedMemoryAlloc(n = 1, sizeof(long));
+            data[0] = c->gravityid;
+            break;
+          case SUB_EWMH_SUBTLE_CLIENT_SCREEN:
+            data    = (long *)subSharedMemoryAlloc(n = 1, sizeof(long));
+            data[0] = c->screenid;
+            break;
+          default: break;
+        }
+    }
+
+  if(data && size) *size = n;
+
+  return (char *)data;
+} /* }}} */
+
  /** subEventLoop {{{
   * @brief Event all X events
   **/
@@ -1715,7 +1864,7 @@ subEventWatchDel(int fd)
 void
 subEventLoop(void)
 {
-  int i, timeout = 1, nevents = 0;
+  int i, timeout = 1000, nevents = 0;
   XEvent ev;
   time_t now;
   SubPanel *p = NULL;
@@ -1771,8 +1920,21 @@ subEventLoop(void)
             subTraySelect();
         }
 
+      /* Handle messages sent outside of hooks */
+      subEventDirectFlush(True);
+
+      /* Publish focus history once per batch of focus changes */
+      if(subtle->flags & SUB_SUBTLE_HISTORY) subClientPublishHistory();
+
+      /* Collect garbage and publish stats when idle */
+      if(0 == XPending(subtle->dpy))
+        {
+          subRubyCollect(timeout);
+          subPoolPublish();
+        }
+
       /* Data ready on any connection */
-      if(0 < (nevents = poll(watches, nwatches, timeout * 1000)))
+      if(0 < (nevents = poll(watches, nwatches, timeout)))
         {
           for(i = 0; i < nwatches; i++) ///< Find descriptor
             {
@@ -1809,20 +1971,32 @@ subEventLoop(void)
 #ifdef HAVE_SYS_INOTIFY_H
                   else if(watches[i].fd == subtle->notify) ///< Inotify {{{
                     {
-                      if(0 < read(subtle->notify, buf, BUFLEN)) ///< Inotify events
-                        {
-                          struct inotify_event *event = (struct inotify_event *)&buf[0];
+                      int len = 0, pos = 0;
 
-                          /* Skip unwatch events */
-                          if(event && IN_IGNORED != event->mask)
+                      if(0 < (len = read(subtle->notify, buf, BUFLEN))) ///< Inotify events
+                        {
+                          while(pos < len)
                             {
-                              if((p = PANEL(subSubtleFind(
+                              struct inotify_event *event =
+                                (struct inotify_event *)&buf[pos];
+
+                              pos += sizeof(struct inotify_event) + event->len;
+
+                              /* Skip unwatch events */
+                              if(IN_IGNORED == event->mask) continue;
+
+                              /* Changed sublet file */
+                              if(event->wd == subtle->watch)
+                                {
+                                  if(0 < event->len)
+                                    subRubyReloadSublet(event->name);
+                                }
+                              else if((p = PANEL(subSubtleFind(
                                   subtle->windows.support, event->wd))))
                                 {
                                   subRubyCall(SUB_CALL_WATCH,
                                     p->sublet->instance, NULL);
-                                  subScreenUpdate();
-                                  subScreenRender();
+                                  subScreenSchedule();
                                 }
                             }
                         }
@@ -1835,8 +2009,7 @@ subEventLoop(void)
                         {
                           subRubyCall(SUB_CALL_WATCH,
                             p->sublet->instance, NULL);
-                          subScreenUpdate();
-                          subScreenRender();
+                          subScreenSchedule();
                         }
                     } /* }}} */
                 }
@@ -1864,11 +2037,18 @@ subEventLoop(void)
                   subArraySort(subtle->sublets, subPanelCompare);
                 }
 
-              subScreenUpdate();
-              subScreenRender();
+              subScreenSchedule();
             }
         } /* }}} */
 
+      /* Retag clients with changed names */
+      if(subtle->flags & SUB_SUBTLE_RETAG && subSubtleTicks() >= subtle->retag)
+        subClientRetagLive();
+
+      /* Render deferred frame */
+      if(subtle->flags & SUB_SUBTLE_RENDER && subSubtleTicks() >= subtle->frame)
+        subScreenRender();
+
       /* Set new timeout */
       if(0 < subtle->sublets->ndata)
         {
@@ -1879,6 +2059,30 @@ subEventLoop(void)
           if(0 >= timeout) timeout = 1; ///< Sanitize
         }
       else timeout = 60;
+
+      timeout *= 1000;
+
+      /* Wake up for deferred frame */
+      if(subtle->flags & SUB_SUBTLE_RENDER)
+        {
+          int wait = 0;
+          unsigned long ticks = subSubtleTicks();
+
+          if(subtle->frame > ticks) wait = subtle->frame - ticks;
+
+          timeout = MIN(timeout, wait);
+        }
+
+      /* Wake up for pending retag */
+      if(subtle->flags & SUB_SUBTLE_RETAG)
+        {
+          int wait = 0;
+          unsigned long ticks = subSubtleTicks();
+
+          if(subtle->retag > ticks) wait = subtle->retag - ticks;
+
+          timeout = MIN(timeout, wait);
+        }
     }
 
   /* Drop tray selection */
@@ -1895,6 +2099,7 @@ subEventFinish(void)
 
   if(watches) free(watches);
   if(queue)   free(queue);
+  if(pending) free(pending);
 } /* }}} */
 
 // vim:ts=2:bs=2:sw=2:et:fdm=marker
@@ -82,7 +82,8 @@ subEwmhInit(void)
     "SUBTLE_SCREEN_PANELS", "SUBTLE_SCREEN_VIEWS", "SUBTLE_SCREEN_JUMP",
     "SUBTLE_VISIBLE_TAGS", "SUBTLE_VISIBLE_VIEWS",
     "SUBTLE_RENDER", "SUBTLE_RELOAD", "SUBTLE_RESTART", "SUBTLE_QUIT",
-    "SUBTLE_COLORS", "SUBTLE_FONT", "SUBTLE_DATA", "SUBTLE_VERSION"
+    "SUBTLE_COLORS", "SUBTLE_FONT", "SUBTLE_DATA", "SUBTLE_VERSION",
+    "SUBTLE_GC", "SUBTLE_NAME_INDEX", "SUBTLE_FOCUS_HISTORY", "SUBTLE_POOLS"
   };
 
   assert(SUB_EWMH_TOTAL == LENGTH(names));
@@ -248,6 +249,27 @@ subEwmhSetCardinals(Window win,
     (unsigned char *)values, size);
 } /* }}} */
 
+ /** subEwmhSetTags {{{
+  * @brief Change tags property of window
+  * @param[in]  win   Window
+  * @param[in]  e     A #SubEwmh
+  * @param[in]  tags  A #SubTags
+  **/
+
+void
+subEwmhSetTags(Window win,
+  SubEwmh e,
+  TAGS *tags)
+{
+  int n = 0;
+  long cards[TAGSCARDS];
+
+  n = subSharedTagsToCards(tags, cards);
+
+  XChangeProperty(subtle->dpy, win, atoms[e], XA_CARDINAL, 32, PropModeReplace,
+    (unsigned char *)cards, n);
+} /* }}} */
+
  /** subEwmhSetString {{{
   * @brief Change window property
   * @param[in]  win    Window
@@ -374,6 +396,47 @@ subEwmhMessage(Window win,
   return XSendEvent(subtle->dpy, win, False, mask, (XEvent *)&ev);
 } /* }}} */
 
+ /** subEwmhPublishNames {{{
+  * @brief Publish hashes of tag and view names, so subtlext can resolve
+  *        names without fetching and matching the string lists
+  **/
+
+void
+subEwmhPublishNames(void)
+{
+  int i, n = 0;
+  long *names = NULL;
+  unsigned long long hash = 0;
+
+  names = (long *)subSharedMemoryAlloc(
+    4 * (subtle->tags->ndata + subtle->views->ndata) + 1, sizeof(long));
+
+  /* Quadruples of 64bit hash in two cardinals, list atom and id */
+  for(i = 0; i < subtle->tags->ndata; i++)
+    {
+      hash = subSharedStringHash(TAG(subtle->tags->data[i])->name);
+
+      names[n++] = (long)(hash & 0xffffffffULL);
+      names[n++] = (long)(hash >> 32);
+      names[n++] = atoms[SUB_EWMH_SUBTLE_TAG_LIST];
+      names[n++] = i;
+    }
+
+  for(i = 0; i < subtle->views->ndata; i++)
+    {
+      hash = subSharedStringHash(VIEW(subtle->views->data[i])->name);
+
+      names[n++] = (long)(hash & 0xffffffffULL);
+      names[n++] = (long)(hash >> 32);
+      names[n++] = atoms[SUB_EWMH_NET_DESKTOP_NAMES];
+      names[n++] = i;
+    }
+
+  subEwmhSetCardinals(ROOT, SUB_EWMH_SUBTLE_NAME_INDEX, names, n);
+
+  free(names);
+} /* }}} */
+
  /** subEwmhFinish {{{
   * @brief Delete set ICCCM/EWMH atoms
   **/
@@ -404,6 +467,10 @@ subEwmhFinish(void)
       subSharedPropertyDelete(subtle->dpy, ROOT, subEwmhGet(SUB_EWMH_SUBTLE_VIEW_TAGS));
       subSharedPropertyDelete(subtle->dpy, ROOT, subEwmhGet(SUB_EWMH_SUBTLE_COLORS));
       subSharedPropertyDelete(subtle->dpy, ROOT, subEwmhGet(SUB_EWMH_SUBTLE_FONT));
+      subSharedPropertyDelete(subtle->dpy, ROOT, subEwmhGet(SUB_EWMH_SUBTLE_GC));
+      subSharedPropertyDelete(subtle->dpy, ROOT, subEwmhGet(SUB_EWMH_SUBTLE_NAME_INDEX));
+      subSharedPropertyDelete(subtle->dpy, ROOT, subEwmhGet(SUB_EWMH_SUBTLE_FOCUS_HISTORY));
+      subSharedPropertyDelete(subtle->dpy, ROOT, subEwmhGet(SUB_EWMH_SUBTLE_POOLS));
       subSharedPropertyDelete(subtle->dpy, ROOT, subEwmhGet(SUB_EWMH_SUBTLE_SUBLET_LIST));
       subSharedPropertyDelete(subtle->dpy, ROOT, subEwmhGet(SUB_EWMH_SUBTLE_SCREEN_VIEWS));
       subSharedPropertyDelete(subtle->dpy, ROOT, subEwmhGet(SUB_EWMH_SUBTLE_VISIBLE_VIEWS));
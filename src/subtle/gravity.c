@@ -36,6 +36,10 @@ subGravityNew(const char *name,
 
   if(name) g->quark = XrmStringToQuark(name); ///< Create hash
 
+  /* Register name, first one wins */
+  if(!subSubtleFind((Window)g->quark, GRAVITYID))
+    XSaveContext(subtle->dpy, (XID)g->quark, GRAVITYID, (void *)g);
+
   /* Sanitize values */
   g->geom.x      = MINMAX(geom->x,      0, 100);
   g->geom.y      = MINMAX(geom->y,      0, 100);
@@ -80,6 +84,10 @@ subGravityKill(SubGravity *g)
 {
   assert(g);
 
+  /* Unregister name */
+  if(g == GRAVITY(subSubtleFind((Window)g->quark, GRAVITYID)))
+    XDeleteContext(subtle->dpy, (XID)g->quark, GRAVITYID);
+
   free(g);
 
   subSubtleLogDebugSubtle("Kill\n");
@@ -103,21 +111,33 @@ subGravityFind(const char *name,
 
   if(0 < subtle->gravities->ndata)
     {
-      int i, hash = 0;
+      int hash = 0;
+      SubGravity *g = NULL;
 
       /* Get quark */
       if(name) hash = XrmStringToQuark(name);
       else hash = quark;
 
-      for(i = 0; i < subtle->gravities->ndata; i++)
+      /* Lookup registered name */
+      if((g = GRAVITY(subSubtleFind((Window)hash, GRAVITYID))))
+        found = subArrayIndex(subtle->gravities, (void *)g);
+
+      /* Scan and register again when a duplicate name was killed */
+      if(-1 == found)
         {
-          SubGravity *g = GRAVITY(subtle->gravities->data[i]);
+          int i;
 
-          /* Compare quarks */
-          if(g->quark == hash)
+          for(i = 0; i < subtle->gravities->ndata; i++)
             {
-              found = i;
-              break;
+              g = GRAVITY(subtle->gravities->data[i]);
+
+              if(g->quark == hash)
+                {
+                  XSaveContext(subtle->dpy, (XID)g->quark, GRAVITYID,
+                    (void *)g);
+                  found = i;
+                  break;
+                }
             }
         }
     }
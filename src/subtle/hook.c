@@ -12,25 +12,70 @@
 
 #include "subtle.h"
 
+/* Globals {{{ */
+static const int types[] = ///< Bucket order
+{
+  SUB_HOOK_START, SUB_HOOK_RELOAD, SUB_HOOK_EXIT, SUB_HOOK_TILE,
+  (SUB_HOOK_TYPE_CLIENT|SUB_HOOK_ACTION_CREATE),
+  (SUB_HOOK_TYPE_CLIENT|SUB_HOOK_ACTION_MODE),
+  (SUB_HOOK_TYPE_CLIENT|SUB_HOOK_ACTION_GRAVITY),
+  (SUB_HOOK_TYPE_CLIENT|SUB_HOOK_ACTION_FOCUS),
+  (SUB_HOOK_TYPE_CLIENT|SUB_HOOK_ACTION_KILL),
+  (SUB_HOOK_TYPE_TAG|SUB_HOOK_ACTION_CREATE),
+  (SUB_HOOK_TYPE_TAG|SUB_HOOK_ACTION_KILL),
+  (SUB_HOOK_TYPE_VIEW|SUB_HOOK_ACTION_CREATE),
+  (SUB_HOOK_TYPE_VIEW|SUB_HOOK_ACTION_FOCUS),
+  (SUB_HOOK_TYPE_VIEW|SUB_HOOK_ACTION_KILL)
+};
+
+static SubArray *buckets[LENGTH(types)] = { NULL }; ///< Hooks per type
+/* }}} */
+
+/* HookBucket {{{ */
+static int
+HookBucket(int type)
+{
+  int i;
+
+  for(i = 0; LENGTH(types) > i; i++)
+    if(types[i] == type) return i;
+
+  return -1;
+} /* }}} */
+
+/* Public */
+
  /** subHookNew {{{
   * @brief Create new hook
   * @param[in]  type  Type of hook
   * @param[in]  proc  Hook proc
+  * @param[in]  filter  Client filter or \p NULL
   * @return Returns a new #SubHook or \p NULL
   **/
 
 SubHook *
 subHookNew(int type,
-  unsigned long proc)
+  unsigned long proc,
+  SubTag *filter)
 {
+  int bucket = -1;
   SubHook *h = NULL;
 
   assert(proc);
 
   /* Create new hook */
   h = HOOK(subSharedMemoryAlloc(1, sizeof(SubHook)));
-  h->flags = (SUB_TYPE_HOOK|type);
-  h->proc  = proc;
+  h->flags  = (SUB_TYPE_HOOK|type);
+  h->proc   = proc;
+  h->filter = filter;
+
+  /* Sort into bucket of its type */
+  if(-1 != (bucket = HookBucket(type)))
+    {
+      if(!buckets[bucket]) buckets[bucket] = subArrayNew();
+
+      subArrayPush(buckets[bucket], (void *)h);
+    }
 
   subSubtleLogDebugSubtle("new=hook, type=%d, proc=%ld\n", type, proc);
 
@@ -47,16 +92,22 @@ void
 subHookCall(int type,
   void *data)
 {
-  int i;
+  int i, bucket = HookBucket(type);
+
+  /* Skip types without any hooks */
+  if(-1 == bucket || !buckets[bucket]) return;
 
-  /* Call matching hooks */
-  for(i = 0; i < subtle->hooks->ndata; i++)
+  /* Call hooks of this type */
+  for(i = 0; buckets[bucket] && i < buckets[bucket]->ndata; i++)
     {
-      SubHook *h = HOOK(subtle->hooks->data[i]);
+      SubHook *h = HOOK(buckets[bucket]->data[i]);
 
-      if((h->flags & ~SUB_TYPE_HOOK) == type)
+      /* Check client filter before entering ruby */
+      if(!h->filter || (type & SUB_HOOK_TYPE_CLIENT && data &&
+          subTagMatcherCheck(h->filter, CLIENT(data))))
         {
-          subRubyCall(SUB_CALL_HOOKS, h->proc, data);
+          subRubyCall(SUB_HOOK_TILE == type ? SUB_CALL_TILE : SUB_CALL_HOOKS,
+            h->proc, data);
 
           subSubtleLogDebug("call=hook, type=%d, proc=%ld, data=%p\n",
             type, h->proc, data);
@@ -64,6 +115,21 @@ subHookCall(int type,
     }
 } /* }}} */
 
+ /** subHookCheck {{{
+  * @brief Check whether hooks of type exist
+  * @param[in]  type  Type of hook
+  * @retval  True   Type has hooks
+  * @retval  False  No hooks of this type
+  **/
+
+int
+subHookCheck(int type)
+{
+  int bucket = HookBucket(type);
+
+  return -1 != bucket && buckets[bucket];
+} /* }}} */
+
  /** subHookKill {{{
   * @brief Kill a hook
   * @param[in]  h  A #SubHook
@@ -72,8 +138,27 @@ subHookCall(int type,
 void
 subHookKill(SubHook *h)
 {
+  int bucket = -1;
+
   assert(h);
 
+  /* Remove from bucket */
+  if(-1 != (bucket = HookBucket(h->flags & ~SUB_TYPE_HOOK)) &&
+      buckets[bucket])
+    {
+      subArrayRemove(buckets[bucket], (void *)h);
+
+      /* Drop empty buckets */
+      if(0 == buckets[bucket]->ndata)
+        {
+          subArrayKill(buckets[bucket], False);
+          buckets[bucket] = NULL;
+        }
+    }
+
+  /* Remove filter */
+  if(h->filter) subTagKill(h->filter);
+
   free(h);
 
   subSubtleLogDebugSubtle("kill=hook\n");
@@ -0,0 +1,414 @@
+
+ /**
+  * @package subtle
+  *
+  * @file Index functions
+  * @copyright (c) 2005-2013 Christoph Kappel <unexist@subforge.org>
+  * @version $Id$
+  *
+  * This program can be distributed under the terms of the GNU GPLv2.
+  * See the file COPYING for details.
+  **/
+
+#include "subtle.h"
+
+/* Private */
+
+/* IndexCompare {{{ */
+static int
+IndexCompare(const void *a,
+  const void *b)
+{
+  SubIndex *i1 = (SubIndex *)a, *i2 = (SubIndex *)b;
+
+  /* Sort by center and keep stacking order of equal centers */
+  if(i1->cx != i2->cx) return i1->cx < i2->cx ? -1 : 1;
+
+  return i1->stack - i2->stack;
+} /* }}} */
+
+/* IndexScreen {{{ */
+static SubScreen *
+IndexScreen(SubClient *c)
+{
+  SubScreen *s = NULL;
+
+  /* Fall back to first screen for stale ids */
+  if(!(s = SCREEN(subArrayGet(subtle->screens, c->screenid))))
+    s = SCREEN(subtle->screens->data[0]);
+
+  return s;
+} /* }}} */
+
+/* IndexUpdate {{{ */
+static void
+IndexUpdate(void)
+{
+  int i, dirty = False;
+  SubScreen *s = NULL;
+
+  /* Reset outdated indices only */
+  for(i = 0; i < subtle->screens->ndata; i++)
+    {
+      s = SCREEN(subtle->screens->data[i]);
+
+      if(!(s->flags & SUB_SCREEN_INDEX))
+        {
+          s->nindex = 0;
+          s->maxw   = 0;
+          dirty     = True;
+        }
+    }
+
+  if(!dirty) return;
+
+  /* Pass 1: Count visible clients per outdated screen */
+  for(i = 0; i < subtle->clients->ndata; i++)
+    {
+      SubClient *c = CLIENT(subtle->clients->data[i]);
+
+      if(VISIBLE(c) && !((s = IndexScreen(c))->flags & SUB_SCREEN_INDEX))
+        s->nindex++;
+    }
+
+  for(i = 0; i < subtle->screens->ndata; i++)
+    {
+      s = SCREEN(subtle->screens->data[i]);
+
+      if(!(s->flags & SUB_SCREEN_INDEX))
+        {
+          s->index  = (SubIndex *)subSharedMemoryRealloc(s->index,
+            MAX(1, s->nindex) * sizeof(SubIndex));
+          s->nindex = 0;
+        }
+    }
+
+  /* Pass 2: Fill index in stacking order */
+  for(i = 0; i < subtle->clients->ndata; i++)
+    {
+      SubClient *c = CLIENT(subtle->clients->data[i]);
+
+      if(VISIBLE(c) && !((s = IndexScreen(c))->flags & SUB_SCREEN_INDEX))
+        {
+          SubIndex *e = &s->index[(s->nindex)++];
+
+          e->client = c;
+          e->geom   = c->geom;
+          e->cx     = c->geom.x + (c->geom.width / 2);
+          e->stack  = i;
+
+          if(c->geom.width > s->maxw) s->maxw = c->geom.width;
+        }
+    }
+
+  /* Sort by center x */
+  for(i = 0; i < subtle->screens->ndata; i++)
+    {
+      s = SCREEN(subtle->screens->data[i]);
+
+      if(!(s->flags & SUB_SCREEN_INDEX))
+        {
+          if(1 < s->nindex)
+            qsort(s->index, s->nindex, sizeof(SubIndex), IndexCompare);
+
+          s->flags |= SUB_SCREEN_INDEX;
+        }
+    }
+
+  subSubtleLogDebugSubtle("Update\n");
+} /* }}} */
+
+/* IndexLower {{{ */
+static int
+IndexLower(SubScreen *s,
+  int x)
+{
+  int lo = 0, hi = s->nindex;
+
+  /* Find first entry with center x not left of x */
+  while(lo < hi)
+    {
+      int mid = lo + (hi - lo) / 2;
+
+      if(s->index[mid].cx < x) lo = mid + 1;
+      else hi = mid;
+    }
+
+  return lo;
+} /* }}} */
+
+/* IndexHistory {{{ */
+static int
+IndexHistory(SubClient *c)
+{
+  int i;
+  SubClient *r = NULL;
+
+  /* Check focus history position */
+  for(i = 0, r = subtle->recent; r && i < HISTORYSIZE; i++, r = r->next)
+    if(r == c) return HISTORYSIZE - i;
+
+  return 0;
+} /* }}} */
+
+/* IndexMatch {{{ */
+static int
+IndexMatch(int type,
+  XRectangle *origin,
+  XRectangle *test)
+{
+  int cx_origin = 0, cx_test = 0, cy_origin = 0, cy_test = 0, dx = 0, dy = 0;
+
+  /* This check is complicated and consists of three parts:
+   * 1) Calculate window center positions
+   * 2) Check if x/y values decrease in given direction
+   * 3) Check if a corner of one of the rects is close enough to
+   *    a side of the other rect */
+
+  /* Calculate window centers */
+  cx_origin = origin->x + (origin->width / 2);
+  cx_test   = test->x + (test->width / 2);
+
+  cy_origin = origin->y + (origin->height / 2);
+  cy_test   = test->y + (test->height / 2);
+
+  /* Check geometries */
+  if((((SUB_GRAB_DIRECTION_LEFT  == type      && cx_test   <= cx_origin)                  ||
+       (SUB_GRAB_DIRECTION_RIGHT == type      && cx_test   >= cx_origin))                 &&
+       ((cy_test                 >= origin->y && cy_test   <= origin->y + origin->height) ||
+       (cy_origin                >= test->y   && cy_origin <= test->y   + test->height))) ||
+
+     (((SUB_GRAB_DIRECTION_UP    == type      && cy_test   <= cy_origin)                  ||
+       (SUB_GRAB_DIRECTION_DOWN  == type      && cy_test   >= cy_origin))                 &&
+       ((cx_test                 >= origin->x && cx_test   <= origin->x + origin->width)  ||
+       (cx_origin                 >= test->x   && cx_origin <= test->x   + test->width))))
+    {
+      /* Euclidean distance */
+      dx = abs(cx_origin - cx_test);
+      dy = abs(cy_origin - cy_test);
+
+      /* Zero distance means same dimensions - highest distance */
+      if(0 == dx && 0 == dy) dx = dy = 1L << 15;
+    }
+  else
+    {
+      /* No match - highest distance too */
+      dx = 1L << 15;
+      dy = 1L << 15;
+    }
+
+  return dx + dy;
+} /* }}} */
+
+/* IndexCheck {{{ */
+static void
+IndexCheck(SubClient *c,
+  int direction,
+  SubIndex *e,
+  int *match,
+  int *stack,
+  SubClient **found)
+{
+  int distance = 0;
+  SubClient *k = e->client;
+
+  /* Check if both clients are different and visible */
+  if(c != k && (subSharedTagsAny(&subtle->visible_tags, &k->tags) ||
+      k->flags & SUB_CLIENT_MODE_STICK))
+    {
+      /* Substract stack and history position to prefer top windows */
+      distance = IndexMatch(direction, &c->geom, &e->geom) -
+        e->stack - IndexHistory(k);
+
+      /* Lower stack position wins on same distance */
+      if(*match > distance || (*match == distance && *stack > e->stack))
+        {
+          *match = distance;
+          *stack = e->stack;
+          *found = k;
+        }
+    }
+} /* }}} */
+
+/* Public */
+
+ /** subIndexDirty {{{
+  * @brief Mark index of screen outdated
+  * @param[in]  screenid  Screen id or -1 for all screens
+  **/
+
+void
+subIndexDirty(int screenid)
+{
+  int i;
+  SubScreen *s = NULL;
+
+  if(!subtle->screens) return;
+
+  if(-1 == screenid)
+    {
+      for(i = 0; i < subtle->screens->ndata; i++)
+        SCREEN(subtle->screens->data[i])->flags &= ~SUB_SCREEN_INDEX;
+    }
+  else if((s = SCREEN(subArrayGet(subtle->screens, screenid))))
+    s->flags &= ~SUB_SCREEN_INDEX;
+  else if(0 < subtle->screens->ndata) ///< Stale ids are indexed on first screen
+    SCREEN(subtle->screens->data[0])->flags &= ~SUB_SCREEN_INDEX;
+} /* }}} */
+
+ /** subIndexSelect {{{
+  * @brief Find nearest visible client in direction
+  * @param[in]  c          A #SubClient
+  * @param[in]  direction  Select direction
+  * @return Returns a #SubClient or \p NULL
+  **/
+
+SubClient *
+subIndexSelect(SubClient *c,
+  int direction)
+{
+  int i, j, cx = 0, bonus = 0, match = (1L << 30), stack = 0;
+  SubClient *found = NULL;
+
+  assert(c);
+
+  IndexUpdate();
+
+  cx    = c->geom.x + (c->geom.width / 2);
+  bonus = subtle->clients->ndata + HISTORYSIZE; ///< Biggest possible bonus
+
+  /* Walk outwards from origin center and stop when the x distance
+   * alone cannot beat the current match anymore */
+  for(i = 0; i < subtle->screens->ndata; i++)
+    {
+      SubScreen *s = SCREEN(subtle->screens->data[i]);
+      int start = IndexLower(s, cx);
+
+      for(j = start; j < s->nindex &&
+          s->index[j].cx - cx - bonus <= match; j++)
+        IndexCheck(c, direction, &s->index[j], &match, &stack, &found);
+
+      for(j = start - 1; 0 <= j &&
+          cx - s->index[j].cx - bonus <= match; j--)
+        IndexCheck(c, direction, &s->index[j], &match, &stack, &found);
+    }
+
+  subSubtleLogDebugSubtle("Select: direction=%d, match=%d\n",
+    direction, match);
+
+  return found;
+} /* }}} */
+
+ /** subIndexFind {{{
+  * @brief Find top visible client at point
+  * @param[in]  x  X position
+  * @param[in]  y  Y position
+  * @return Returns a #SubClient or \p NULL
+  **/
+
+SubClient *
+subIndexFind(int x,
+  int y)
+{
+  int i, j, stack = -1;
+  SubClient *found = NULL;
+
+  IndexUpdate();
+
+  for(i = 0; i < subtle->screens->ndata; i++)
+    {
+      SubScreen *s = SCREEN(subtle->screens->data[i]);
+
+      /* Only clients with a center within the widest half can match */
+      for(j = IndexLower(s, x - (s->maxw / 2) - 1); j < s->nindex &&
+          s->index[j].cx <= x + (s->maxw / 2); j++)
+        {
+          SubIndex *e = &s->index[j];
+
+          if(e->stack > stack && XYINRECT(x, y, e->geom))
+            {
+              stack = e->stack;
+              found = e->client;
+            }
+        }
+    }
+
+  return found;
+} /* }}} */
+
+ /** subIndexSnap {{{
+  * @brief Snap geom to edges of neighbor clients
+  * @param[in]     c     A #SubClient
+  * @param[in]     s     A #SubScreen
+  * @param[inout]  geom  A #XRectangle
+  **/
+
+void
+subIndexSnap(SubClient *c,
+  SubScreen *s,
+  XRectangle *geom)
+{
+  int j, cx = 0, range = 0, snapx = False, snapy = False;
+  int left = 0, right = 0, top = 0, bottom = 0;
+
+  assert(c && s && geom);
+
+  IndexUpdate();
+
+  /* Outer edges of geom */
+  left   = geom->x - BORDER(c);
+  right  = geom->x + geom->width + BORDER(c);
+  top    = geom->y - BORDER(c);
+  bottom = geom->y + geom->height + BORDER(c);
+
+  cx    = geom->x + (geom->width / 2);
+  range = (s->maxw + geom->width) / 2 + 2 * subtle->styles.clients.border.top +
+    subtle->snap + 1;
+
+  for(j = IndexLower(s, cx - range); j < s->nindex &&
+      s->index[j].cx <= cx + range && !(snapx && snapy); j++)
+    {
+      SubIndex *e = &s->index[j];
+      int bw = 0;
+
+      /* Skip own and desktop windows */
+      if(e->client == c || e->client->flags & SUB_CLIENT_TYPE_DESKTOP)
+        continue;
+
+      bw = BORDER(e->client);
+
+      /* Snap to left or right edge of neighbor - X axis */
+      if(!snapx && top < e->geom.y + e->geom.height + bw &&
+          e->geom.y - bw < bottom)
+        {
+          if(abs((e->geom.x + e->geom.width + bw) - left) <= subtle->snap)
+            {
+              geom->x = e->geom.x + e->geom.width + bw + BORDER(c);
+              snapx   = True;
+            }
+          else if(abs((e->geom.x - bw) - right) <= subtle->snap)
+            {
+              geom->x = e->geom.x - bw - geom->width - BORDER(c);
+              snapx   = True;
+            }
+        }
+
+      /* Snap to top or bottom edge of neighbor - Y axis */
+      if(!snapy && left < e->geom.x + e->geom.width + bw &&
+          e->geom.x - bw < right)
+        {
+          if(abs((e->geom.y + e->geom.height + bw) - top) <= subtle->snap)
+            {
+              geom->y = e->geom.y + e->geom.height + bw + BORDER(c);
+              snapy   = True;
+            }
+          else if(abs((e->geom.y - bw) - bottom) <= subtle->snap)
+            {
+              geom->y = e->geom.y - bw - geom->height - BORDER(c);
+              snapy   = True;
+            }
+        }
+    }
+} /* }}} */
+
+// vim:ts=2:bs=2:sw=2:et:fdm=marker
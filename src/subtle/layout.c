@@ -0,0 +1,206 @@
+
+ /**
+  * @package subtle
+  *
+  * @file Layout functions
+  * @copyright (c) 2005-2013 Christoph Kappel <unexist@subforge.org>
+  * @version $Id$
+  *
+  * This program can be distributed under the terms of the GNU GPLv2.
+  * See the file COPYING for details.
+  **/
+
+#include "subtle.h"
+
+/* Typedef {{{ */
+typedef struct layoutarrange_t
+{
+  const char *name;
+  void (*arrange)(SubView *v, XRectangle *area, XRectangle *rects, int n);
+} LayoutArrange;
+/* }}} */
+
+/* LayoutSplit {{{ */
+static void
+LayoutSplit(XRectangle *area,
+  XRectangle *rects,
+  int n,
+  int horz)
+{
+  int i, calc = 0, fix = 0;
+
+  if(0 >= n) return;
+
+  /* Calculate size and rounding fix */
+  calc = (horz ? area->width : area->height) / n;
+  fix  = (horz ? area->width : area->height) - calc * n;
+
+  for(i = 0; i < n; i++)
+    {
+      rects[i] = *area;
+
+      if(horz)
+        {
+          rects[i].x     = area->x + i * calc;
+          rects[i].width = i == n - 1 ? calc + fix : calc;
+        }
+      else
+        {
+          rects[i].y      = area->y + i * calc;
+          rects[i].height = i == n - 1 ? calc + fix : calc;
+        }
+    }
+} /* }}} */
+
+/* LayoutMaster {{{ */
+static void
+LayoutMaster(SubView *v,
+  XRectangle *area,
+  XRectangle *rects,
+  int n)
+{
+  int master = MINMAX(v->master, 1, n);
+  XRectangle left = *area, right = *area;
+
+  /* Just one column when stack is empty */
+  if(n <= master)
+    {
+      LayoutSplit(area, rects, n, False);
+
+      return;
+    }
+
+  left.width  = (unsigned short)(area->width * v->ratio);
+  right.x     = area->x + left.width;
+  right.width = area->width - left.width;
+
+  LayoutSplit(&left,  rects,          master,     False);
+  LayoutSplit(&right, rects + master, n - master, False);
+} /* }}} */
+
+/* LayoutGrid {{{ */
+static void
+LayoutGrid(SubView *v,
+  XRectangle *area,
+  XRectangle *rects,
+  int n)
+{
+  int i, cols = 1, rows = 0;
+  XRectangle row = *area;
+
+  /* Find smallest square grid */
+  while(cols * cols < n) cols++;
+  rows = (n + cols - 1) / cols;
+
+  row.height = area->height / rows;
+
+  /* Fill rows, the last one takes remaining clients and height */
+  for(i = 0; i < rows; i++)
+    {
+      int used = MIN(cols, n - i * cols);
+
+      row.y = area->y + i * row.height;
+
+      if(i == rows - 1)
+        row.height = area->height - i * row.height;
+
+      LayoutSplit(&row, rects + i * cols, used, True);
+    }
+} /* }}} */
+
+/* LayoutSpiral {{{ */
+static void
+LayoutSpiral(SubView *v,
+  XRectangle *area,
+  XRectangle *rects,
+  int n)
+{
+  int i;
+  XRectangle rest = *area;
+
+  /* Each client takes a share of the remaining space */
+  for(i = 0; i < n - 1; i++)
+    {
+      rects[i] = rest;
+
+      if(0 == i % 2)
+        {
+          rects[i].width = (unsigned short)(rest.width * v->ratio);
+          rest.x        += rects[i].width;
+          rest.width    -= rects[i].width;
+        }
+      else
+        {
+          rects[i].height = (unsigned short)(rest.height * v->ratio);
+          rest.y         += rects[i].height;
+          rest.height    -= rects[i].height;
+        }
+    }
+
+  rects[n - 1] = rest;
+} /* }}} */
+
+/* LayoutMonocle {{{ */
+static void
+LayoutMonocle(SubView *v,
+  XRectangle *area,
+  XRectangle *rects,
+  int n)
+{
+  int i;
+
+  for(i = 0; i < n; i++) rects[i] = *area;
+} /* }}} */
+
+/* Globals {{{ */
+static const LayoutArrange layouts[] =
+{
+  { "master",  LayoutMaster  },
+  { "grid",    LayoutGrid    },
+  { "spiral",  LayoutSpiral  },
+  { "monocle", LayoutMonocle }
+};
+/* }}} */
+
+/* Public */
+
+ /** subLayoutFind {{{
+  * @brief Find layout id
+  * @param[in]  name  Name of the layout
+  * @return Returns layout id or \p -1
+  **/
+
+int
+subLayoutFind(const char *name)
+{
+  int i;
+
+  assert(name);
+
+  for(i = 0; LENGTH(layouts) > i; i++)
+    if(0 == strcmp(layouts[i].name, name)) return i;
+
+  return -1;
+} /* }}} */
+
+ /** subLayoutGeometry {{{
+  * @brief Calculate geometries of all clients of a view in one pass
+  * @param[in]     v      A #SubView
+  * @param[in]     area   Area to fill
+  * @param[inout]  rects  Geometry for each client
+  * @param[in]     n      Number of clients
+  **/
+
+void
+subLayoutGeometry(SubView *v,
+  XRectangle *area,
+  XRectangle *rects,
+  int n)
+{
+  assert(v && area && rects);
+
+  if(0 < n && 0 <= v->layoutid && LENGTH(layouts) > v->layoutid)
+    layouts[v->layoutid].arrange(v, area, rects, n);
+} /* }}} */
+
+// vim:ts=2:bs=2:sw=2:et:fdm=marker
@@ -12,10 +12,105 @@
 
 #include "subtle.h"
 
-/* PanelRect {{{ */
+#define PANELFILL   0 ///< Layer of fillings
+#define PANELBORDER 1 ///< Layer of borders, painted above fillings
+
+/* Typedef {{{ */
+typedef struct panelbatch_t
+{
+  unsigned long color;
+  int           layer, nrects, size;
+  XRectangle    *rects;
+} PanelBatch;
+/* }}} */
+
+/* Globals {{{ */
+static PanelBatch *batches = NULL;
+static int nbatches = 0;
+/* }}} */
+
+/* Private */
+
+/* PanelBatchAdd {{{ */
 static void
-PanelRect(Drawable drawable,
+PanelBatchAdd(int layer,
+  unsigned long color,
   int x,
+  int y,
+  int width,
+  int height)
+{
+  int i;
+  PanelBatch *b = NULL;
+
+  /* Skip empty rects like unset borders */
+  if(0 >= width || 0 >= height) return;
+
+  /* Find batch for layer and color */
+  for(i = 0; i < nbatches; i++)
+    {
+      if(batches[i].layer == layer && batches[i].color == color)
+        {
+          b = &batches[i];
+
+          break;
+        }
+    }
+
+  /* Create new batch */
+  if(!b)
+    {
+      batches = (PanelBatch *)subSharedMemoryRealloc(batches,
+        (nbatches + 1) * sizeof(PanelBatch));
+
+      b = &batches[nbatches++];
+      b->color  = color;
+      b->layer  = layer;
+      b->nrects = 0;
+      b->size   = 0;
+      b->rects  = NULL;
+    }
+
+  /* Grow rects */
+  if(b->nrects == b->size)
+    {
+      b->size  = 0 == b->size ? 16 : b->size * 2;
+      b->rects = (XRectangle *)subSharedMemoryRealloc(b->rects,
+        b->size * sizeof(XRectangle));
+    }
+
+  b->rects[b->nrects].x        = x;
+  b->rects[b->nrects].y        = y;
+  b->rects[b->nrects].width    = width;
+  b->rects[b->nrects++].height = height;
+} /* }}} */
+
+/* PanelBatchFlush {{{ */
+static void
+PanelBatchFlush(int layer,
+  Drawable drawable)
+{
+  int i;
+
+  /* Fill rects of each color at once */
+  for(i = 0; i < nbatches; i++)
+    {
+      PanelBatch *b = &batches[i];
+
+      if(b->layer == layer && 0 < b->nrects)
+        {
+          XSetForeground(subtle->dpy, subtle->gcs.draw, b->color);
+          XFillRectangles(subtle->dpy, drawable, subtle->gcs.draw,
+            b->rects, b->nrects);
+
+          b->nrects = 0;
+        }
+    }
+} /* }}} */
+
+/* PanelRect {{{ */
+static void
+PanelRect(int x,
   int width,
   SubStyle *s)
 {
@@ -23,43 +118,38 @@ PanelRect(Drawable drawable,
   int mh = s->margin.top + s->margin.bottom;
 
   /* Filling */
-  XSetForeground(subtle->dpy, subtle->gcs.draw, s->bg);
-  XFillRectangle(subtle->dpy, drawable, subtle->gcs.draw,
-    x + s->margin.left, s->margin.top, width - mw, subtle->ph - mh);
+  PanelBatchAdd(PANELFILL, s->bg, x + s->margin.left, s->margin.top,
+    width - mw, subtle->ph - mh);
 
   /* Borders */
-  XSetForeground(subtle->dpy, subtle->gcs.draw, s->top);
-  XFillRectangle(subtle->dpy, drawable, subtle->gcs.draw,
-    x + s->margin.left, s->margin.top, width - mw, s->border.top);
-
-  XSetForeground(subtle->dpy, subtle->gcs.draw, s->right);
-  XFillRectangle(subtle->dpy, drawable, subtle->gcs.draw,
-    x + width - s->border.right - s->margin.right, s->margin.top,
-    s->border.right, subtle->ph - mh);
-
-  XSetForeground(subtle->dpy, subtle->gcs.draw, s->bottom);
-  XFillRectangle(subtle->dpy, drawable, subtle->gcs.draw,
-    x + s->margin.left, subtle->ph - s->border.bottom - s->margin.bottom,
+  PanelBatchAdd(PANELBORDER, s->top, x + s->margin.left, s->margin.top,
+    width - mw, s->border.top);
+  PanelBatchAdd(PANELBORDER, s->right,
+    x + width - s->border.right - s->margin.right,
+    s->margin.top, s->border.right, subtle->ph - mh);
+  PanelBatchAdd(PANELBORDER, s->bottom, x + s->margin.left,
+    subtle->ph - s->border.bottom - s->margin.bottom,
     width - mw, s->border.bottom);
-
-  XSetForeground(subtle->dpy, subtle->gcs.draw, s->left);
-  XFillRectangle(subtle->dpy, drawable, subtle->gcs.draw,
-    x + s->margin.left, s->margin.top, s->border.left, subtle->ph - mh);
+  PanelBatchAdd(PANELBORDER, s->left, x + s->margin.left, s->margin.top,
+    s->border.left, subtle->ph - mh);
 } /* }}} */
 
 /* PanelSeparator {{{ */
 static void
 PanelSeparator(int x,
   SubStyle *s,
-  Drawable drawable)
+  Drawable drawable,
+  int fill)
 {
   /* Set window background and border*/
-  PanelRect(drawable, x, s->separator->width, s);
-
-  subSharedDrawString(subtle->dpy, subtle->gcs.draw,
-    s->font, drawable, x + STYLE_LEFT((*s)),
-    s->font->y + STYLE_TOP((*s)), s->fg, s->bg,
-    s->separator->string, strlen(s->separator->string));
+  if(fill) PanelRect(x, s->separator->width, s);
+  else
+    {
+      subSharedDrawString(subtle->dpy, subtle->gcs.draw,
+        s->font, drawable, x + STYLE_LEFT((*s)),
+        s->font->y + STYLE_TOP((*s)), s->fg, s->bg,
+        s->separator->string, strlen(s->separator->string));
+    }
 } /* }}} */
 
 /* PanelClientModes {{{ */
@@ -107,7 +197,8 @@ PanelViewStyle(SubView *v,
         {
           if(subtle->styles.focus && focus)
             style = subtle->styles.focus;
-          else if(subtle->styles.occupied && subtle->client_tags & v->tags)
+          else if(subtle->styles.occupied &&
+              subSharedTagsAny(&subtle->client_tags, &v->tags))
             style = subtle->styles.occupied;
         }
 
@@ -115,12 +206,13 @@ PanelViewStyle(SubView *v,
       subStyleMerge(s, !style ? &subtle->styles.views : style);
 
       /* Apply modifiers */
-      if(subtle->styles.urgent && subtle->urgent_tags & v->tags)
+      if(subtle->styles.urgent &&
+          subSharedTagsAny(&subtle->urgent_tags, &v->tags))
         subStyleMerge(s, subtle->styles.urgent);
 
       if(subtle->styles.visible)
         {
-          if(subtle->visible_views & (1L << (idx + 1)))
+          if(subSharedTagsTest(&subtle->visible_views, idx))
             subStyleMerge(s, subtle->styles.visible);
         }
 
@@ -155,7 +247,7 @@ subPanelNew(int type)
   SubPanel *p = NULL;
 
   /* Create new panel */
-  p = PANEL(subSharedMemoryAlloc(1, sizeof(SubPanel)));
+  p = PANEL(subPoolAlloc(subtle->pools.panels));
   p->flags = (SUB_TYPE_PANEL|type);
 
   /* Handle panel item type */
@@ -185,13 +277,18 @@ subPanelNew(int type)
  /** subPanelUpdate {{{
   * @brief Update panel
   * @param[in]  p  A #SubPanel
+  * @return Whether the width of the panel changed
   **/
 
-void
+int
 subPanelUpdate(SubPanel *p)
 {
+  int oldwidth = 0;
+
   assert(p);
 
+  oldwidth = p->width;
+
   /* Handle panel item type */
   switch(p->flags & (SUB_PANEL_ICON|SUB_PANEL_KEYCHAIN|
       SUB_PANEL_SUBLET|SUB_PANEL_TITLE|SUB_PANEL_VIEWS))
@@ -201,16 +298,27 @@ subPanelUpdate(SubPanel *p)
           subtle->styles.separator.padding.right + 4;
         break; /* }}} */
       case SUB_PANEL_KEYCHAIN: /* {{{ */
-        p->width = 0;
-
-        if(p->keychain && p->keychain->keys)
           {
-            /* Font offset, panel border and padding */
-            p->width = subSharedStringWidth(subtle->dpy,
-              subtle->styles.separator.font, p->keychain->keys,
-              p->keychain->len, NULL, NULL, True) +
-              subtle->styles.separator.padding.left +
-              subtle->styles.separator.padding.right;
+            unsigned long digest = subtle->fontgen + 1;
+
+            if(p->keychain && p->keychain->keys)
+              digest ^= (unsigned long)subSharedStringHash(p->keychain->keys);
+
+            /* Skip measuring unchanged keys */
+            if(p->digest == digest) break;
+
+            p->digest = digest;
+            p->width  = 0;
+
+            if(p->keychain && p->keychain->keys)
+              {
+                /* Font offset, panel border and padding */
+                p->width = subSharedStringWidth(subtle->dpy,
+                  subtle->styles.separator.font, p->keychain->keys,
+                  p->keychain->len, NULL, NULL, True) +
+                  subtle->styles.separator.padding.left +
+                  subtle->styles.separator.padding.right;
+              }
           }
         break; /* }}} */
       case SUB_PANEL_SUBLET: /* {{{ */
@@ -222,37 +330,43 @@ subPanelUpdate(SubPanel *p)
           }
         break; /* }}} */
       case SUB_PANEL_TITLE: /* {{{ */
-        p->width = subtle->styles.clients.min;
-
-        if(0 < subtle->clients->ndata)
           {
             SubClient *c = NULL;
+            unsigned long digest = subtle->fontgen + 1;
 
             /* Find focus window */
-            if((c = CLIENT(subSubtleFind(subtle->windows.focus[0], CLIENTID))))
+            if(0 < subtle->clients->ndata &&
+                (c = CLIENT(subSubtleFind(subtle->windows.focus, CLIENTID))) &&
+                ALIVE(c) && !(c->flags & SUB_CLIENT_TYPE_DESKTOP))
               {
-                assert(c);
-                DEAD(c);
+                digest ^= (unsigned long)subSharedStringHash(c->name) ^
+                  (c->flags & MODES_ALL) ^ (c->win << 1);
+              }
+            else c = NULL; ///< Exclude dead and desktop type windows
 
-                /* Exclude desktop type windows */
-                if(!(c->flags & SUB_CLIENT_TYPE_DESKTOP))
-                  {
-                    char buf[5] = { 0 };
-                    int width = 0, len = strlen(c->name);
+            /* Skip measuring unchanged title */
+            if(p->digest == digest) break;
+
+            p->digest = digest;
+            p->width  = subtle->styles.clients.min;
 
-                    PanelClientModes(c, buf, &width);
+            if(c)
+              {
+                char buf[5] = { 0 };
+                int width = 0, len = strlen(c->name);
 
-                    /* Font offset, panel border and padding */
-                    p->width = subSharedStringWidth(subtle->dpy,
-                      subtle->styles.title.font, c->name,
-                      /* Limit string length */
-                      len > subtle->styles.clients.right ?
-                      subtle->styles.clients.right : len, NULL, NULL, True) +
-                      width + STYLE_WIDTH(subtle->styles.title);
+                PanelClientModes(c, buf, &width);
 
-                    /* Ensure min width */
-                    p->width = MAX(subtle->styles.clients.min, p->width);
-                  }
+                /* Font offset, panel border and padding */
+                p->width = subSharedStringWidth(subtle->dpy,
+                  subtle->styles.title.font, c->name,
+                  /* Limit string length */
+                  len > subtle->styles.clients.right ?
+                  subtle->styles.clients.right : len, NULL, NULL, True) +
+                  width + STYLE_WIDTH(subtle->styles.title);
+
+                /* Ensure min width */
+                p->width = MAX(subtle->styles.clients.min, p->width);
               }
           }
         break; /* }}} */
@@ -272,7 +386,7 @@ subPanelUpdate(SubPanel *p)
 
                 /* Skip dynamic views */
                 if(v->flags & SUB_VIEW_DYNAMIC &&
-                    !(subtle->client_tags & v->tags))
+                    !subSharedTagsAny(&subtle->client_tags, &v->tags))
                   continue;
 
                 PanelViewStyle(v, i, (p->screen->viewid == i), &s);
@@ -282,9 +396,17 @@ subPanelUpdate(SubPanel *p)
                   v->width = v->icon->width + STYLE_WIDTH((s));
                 else
                   {
-                    v->width = subSharedStringWidth(subtle->dpy, s.font,
-                      v->name, strlen(v->name), NULL, NULL, True) +
-                      STYLE_WIDTH((s)) + (v->icon ? v->icon->width + 3 : 0);
+                    /* Names don't change, measure again on font change */
+                    if(v->font != s.font || v->fontgen != subtle->fontgen)
+                      {
+                        v->textwidth = subSharedStringWidth(subtle->dpy,
+                          s.font, v->name, strlen(v->name), NULL, NULL, True);
+                        v->font      = s.font;
+                        v->fontgen   = subtle->fontgen;
+                      }
+
+                    v->width = v->textwidth + STYLE_WIDTH((s)) +
+                      (v->icon ? v->icon->width + 3 : 0);
                   }
 
                 /* Ensure panel min width */
@@ -301,18 +423,22 @@ subPanelUpdate(SubPanel *p)
         break; /* }}} */
     }
 
-  subSubtleLogDebugSubtle("Update\n");
+  subSubtleLogDebugSubtle("Update: width=%d\n", p->width);
+
+  return oldwidth != p->width;
 } /* }}} */
 
  /** subPanelRender {{{
   * @brief Render panel
   * @param[in]  p         A #SubPanel
   * @param[in]  drawable  Drawable for renderer
+  * @param[in]  fill      Queue backgrounds/borders or draw content
   **/
 
 void
 subPanelRender(SubPanel *p,
-  Drawable drawable)
+  Drawable drawable,
+  int fill)
 {
   assert(p);
 
@@ -320,7 +446,7 @@ subPanelRender(SubPanel *p,
   if(p->flags & SUB_PANEL_SEPARATOR1 && subtle->styles.separator.separator)
     {
       PanelSeparator(p->x - subtle->styles.separator.separator->width,
-        &subtle->styles.separator, drawable);
+        &subtle->styles.separator, drawable, fill);
     }
 
   /* Handle panel item type */
@@ -328,6 +454,7 @@ subPanelRender(SubPanel *p,
       SUB_PANEL_SUBLET|SUB_PANEL_TITLE|SUB_PANEL_VIEWS))
     {
       case SUB_PANEL_ICON: /* {{{ */
+        if(!fill)
           {
             int y = 0, icony = 0;
 
@@ -343,7 +470,7 @@ subPanelRender(SubPanel *p,
           }
         break; /* }}} */
       case SUB_PANEL_KEYCHAIN: /* {{{ */
-        if(p->keychain && p->keychain->keys)
+        if(!fill && p->keychain && p->keychain->keys)
           {
             subSharedDrawString(subtle->dpy, subtle->gcs.draw,
               subtle->styles.separator.font, drawable,
@@ -359,12 +486,14 @@ subPanelRender(SubPanel *p,
             SubStyle *s = PanelSubletStyle(p);
 
             /* Set window background and border*/
-            PanelRect(drawable, p->x, p->width, s);
-
-            /* Render text parts */
-            subTextRender(p->sublet->text, s->font, subtle->gcs.draw,
-              drawable, p->x + STYLE_LEFT((*s)), s->font->y +
-              STYLE_TOP((*s)), s->fg, s->icon, s->bg);
+            if(fill) PanelRect(p->x, p->width, s);
+            else
+              {
+                /* Render text parts */
+                subTextRender(p->sublet->text, s->font, subtle->gcs.draw,
+                  drawable, p->x + STYLE_LEFT((*s)), s->font->y +
+                  STYLE_TOP((*s)), s->fg, s->icon, s->bg);
+              }
           }
         break; /* }}} */
       case SUB_PANEL_TITLE: /* {{{ */
@@ -372,7 +501,7 @@ subPanelRender(SubPanel *p,
           {
             SubClient *c = NULL;
 
-            if((c = CLIENT(subSubtleFind(subtle->windows.focus[0], CLIENTID))) &&
+            if((c = CLIENT(subSubtleFind(subtle->windows.focus, CLIENTID))) &&
                 !(c->flags & SUB_CLIENT_TYPE_DESKTOP) && VISIBLE(c))
               {
                 int x = 0, y = 0, width = 0, len = 0;
@@ -380,10 +509,15 @@ subPanelRender(SubPanel *p,
 
                 DEAD(c);
 
-                PanelClientModes(c, buf, &width);
-
                 /* Set window background and border*/
-                PanelRect(drawable, p->x, p->width, &subtle->styles.title);
+                if(fill)
+                  {
+                    PanelRect(p->x, p->width, &subtle->styles.title);
+
+                    break;
+                  }
+
+                PanelClientModes(c, buf, &width);
 
                 /* Draw modes and title */
                 len = strlen(c->name);
@@ -420,38 +554,41 @@ subPanelRender(SubPanel *p,
 
                 /* Skip dynamic views */
                 if(v->flags & SUB_VIEW_DYNAMIC &&
-                    !(subtle->client_tags & v->tags))
+                    !subSharedTagsAny(&subtle->client_tags, &v->tags))
                   continue;
 
                 PanelViewStyle(v, i, (p->screen->viewid == i), &s);
 
                 /* Set window background and border*/
-                PanelRect(drawable, vx, v->width, &s);
-
-                x += STYLE_LEFT((s));
-
-                /* Draw view icon and/or text */
-                if(v->flags & SUB_VIEW_ICON)
+                if(fill) PanelRect(vx, v->width, &s);
+                else
                   {
-                    int y = 0, icony = 0;
+                    x += STYLE_LEFT((s));
 
-                    y     = s.font->y + STYLE_TOP((s));
-                    icony = v->icon->height > y ? s.margin.top :
-                      y - v->icon->height;
+                    /* Draw view icon and/or text */
+                    if(v->flags & SUB_VIEW_ICON)
+                      {
+                        int y = 0, icony = 0;
 
-                    subSharedDrawIcon(subtle->dpy, subtle->gcs.draw,
-                      drawable, vx + x, icony, v->icon->width,
-                      v->icon->height, s.icon, s.bg, v->icon->pixmap,
-                      v->icon->bitmap);
-                  }
+                        y     = s.font->y + STYLE_TOP((s));
+                        icony = v->icon->height > y ? s.margin.top :
+                          y - v->icon->height;
 
-                if(!(v->flags & SUB_VIEW_ICON_ONLY))
-                  {
-                    if(v->flags & SUB_VIEW_ICON) x += v->icon->width + 3;
+                        subSharedDrawIcon(subtle->dpy, subtle->gcs.draw,
+                          drawable, vx + x, icony, v->icon->width,
+                          v->icon->height, s.icon, s.bg, v->icon->pixmap,
+                          v->icon->bitmap);
+                      }
 
-                    subSharedDrawString(subtle->dpy, subtle->gcs.draw,
-                      s.font, drawable, vx + x, s.font->y +
-                      STYLE_TOP((s)), s.fg, s.bg, v->name, strlen(v->name));
+                    if(!(v->flags & SUB_VIEW_ICON_ONLY))
+                      {
+                        if(v->flags & SUB_VIEW_ICON) x += v->icon->width + 3;
+
+                        subSharedDrawString(subtle->dpy, subtle->gcs.draw,
+                          s.font, drawable, vx + x, s.font->y +
+                          STYLE_TOP((s)), s.fg, s.bg, v->name,
+                          strlen(v->name));
+                      }
                   }
 
                 vx += v->width;
@@ -459,7 +596,7 @@ subPanelRender(SubPanel *p,
                 /* Draw view separator if any */
                 if(subtle->styles.viewsep && i < subtle->views->ndata - 1)
                   {
-                    PanelSeparator(vx, subtle->styles.viewsep, drawable);
+                    PanelSeparator(vx, subtle->styles.viewsep, drawable, fill);
 
                     vx += subtle->styles.viewsep->separator->width;
                   }
@@ -474,12 +611,27 @@ subPanelRender(SubPanel *p,
       SubStyle *s = p->flags & SUB_PANEL_SUBLET && subtle->styles.subletsep ?
         subtle->styles.subletsep : &subtle->styles.separator;
 
-      PanelSeparator(p->x + p->width, s, drawable);
+      PanelSeparator(p->x + p->width, s, drawable, fill);
     }
 
   subSubtleLogDebugSubtle("Render\n");
 } /* }}} */
 
+ /** subPanelFlush {{{
+  * @brief Submit queued panel rects with one request per layer and color
+  * @param[in]  drawable  Drawable for renderer
+  **/
+
+void
+subPanelFlush(Drawable drawable)
+{
+  /* Fillings before borders */
+  PanelBatchFlush(PANELFILL,   drawable);
+  PanelBatchFlush(PANELBORDER, drawable);
+
+  subSubtleLogDebugSubtle("Flush: batches=%d\n", nbatches);
+} /* }}} */
+
  /** subPanelCompare {{{
   * @brief Compare two panels
   * @param[in]  a  A #SubPanel
@@ -580,7 +732,7 @@ subPanelAction(SubArray *panels,
 
                         /* Skip dynamic views */
                         if(v->flags & SUB_VIEW_DYNAMIC &&
-                            !(subtle->client_tags & v->tags))
+                            !subSharedTagsAny(&subtle->client_tags, &v->tags))
                           continue;
 
                         /* Check if x is in view rect */
@@ -688,6 +840,24 @@ subPanelPublish(void)
   free(sublets);
 } /* }}} */
 
+ /** subPanelFinish {{{
+  * @brief Free queued panel rects
+  **/
+
+void
+subPanelFinish(void)
+{
+  int i;
+
+  for(i = 0; i < nbatches; i++)
+    if(batches[i].rects) free(batches[i].rects);
+
+  if(batches) free(batches);
+
+  batches  = NULL;
+  nbatches = 0;
+} /* }}} */
+
  /** subPanelKill {{{
   * @brief Kill a panel
   * @param[in]  p  A #SubPanel
@@ -747,6 +917,7 @@ subPanelKill(SubPanel *p)
                 printf("Unloaded sublet (%s)\n", p->sublet->name);
                 free(p->sublet->name);
               }
+            if(p->sublet->path) free(p->sublet->path);
             if(p->sublet->text) subTextKill(p->sublet->text);
 
             free(p->sublet);
@@ -759,7 +930,7 @@ subPanelKill(SubPanel *p)
         return; /* }}} */
     }
 
-  free(p);
+  subPoolFree(subtle->pools.panels, p);
 
   subSubtleLogDebugSubtle("Kill\n");
 } /* }}} */
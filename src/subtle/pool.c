@@ -0,0 +1,219 @@
+
+ /**
+  * @package subtle
+  *
+  * @file Pool functions
+  * @copyright (c) 2005-2013 Christoph Kappel <unexist@subforge.org>
+  * @version $Id$
+  *
+  * This program can be distributed under the terms of the GNU GPLv2.
+  * See the file COPYING for details.
+  **/
+
+#include "subtle.h"
+
+#define POOLALIGN 16 ///< Alignment of pool objects
+
+/* Typedef {{{ */
+typedef union poolslab_t
+{
+  union poolslab_t *next;
+  char             align[POOLALIGN];
+} PoolSlab;
+
+typedef union poolitem_t
+{
+  union poolitem_t *next;
+  char             align[POOLALIGN];
+} PoolItem;
+/* }}} */
+
+/* Private */
+
+/* PoolGrow {{{ */
+static void
+PoolGrow(SubPool *p)
+{
+  int i;
+  char *base = NULL;
+  PoolSlab *slab = NULL;
+
+  /* Objects follow the slab header */
+  slab       = (PoolSlab *)subSharedMemoryAlloc(1,
+    sizeof(PoolSlab) + p->perslab * p->size);
+  slab->next = p->slabs;
+  p->slabs   = slab;
+  base       = (char *)(slab + 1);
+
+  /* Thread objects onto free list, lowest address first */
+  for(i = p->perslab - 1; 0 <= i; i--)
+    {
+      PoolItem *item = (PoolItem *)(base + i * p->size);
+
+      item->next = p->free;
+      p->free    = item;
+    }
+
+  p->nslabs++;
+
+  subSubtleLogDebugSubtle("Grow: name=%s, slabs=%lu, objects=%lu\n",
+    p->name, p->nslabs, p->nslabs * p->perslab);
+} /* }}} */
+
+/* Public */
+
+ /** subPoolNew {{{
+  * @brief Create new object pool
+  * @param[in]  name     Name for statistics
+  * @param[in]  size     Size of the objects
+  * @param[in]  perslab  Objects per slab
+  * @return Returns a new #SubPool
+  **/
+
+SubPool *
+subPoolNew(const char *name,
+  size_t size,
+  int perslab)
+{
+  SubPool *p = NULL;
+
+  assert(name && 0 < size && 0 < perslab);
+
+  p = (SubPool *)subSharedMemoryAlloc(1, sizeof(SubPool));
+  p->name    = name;
+  p->size    = (MAX(size, sizeof(PoolItem)) + POOLALIGN - 1) &
+    ~(size_t)(POOLALIGN - 1);
+  p->perslab = perslab;
+
+  subSubtleLogDebugSubtle("New: name=%s, size=%zu\n", name, p->size);
+
+  return p;
+} /* }}} */
+
+ /** subPoolAlloc {{{
+  * @brief Get cleared object from pool
+  * @param[in]  p  A #SubPool
+  * @return Returns a new object
+  **/
+
+void *
+subPoolAlloc(SubPool *p)
+{
+  PoolItem *item = NULL;
+
+  assert(p);
+
+  if(!p->free) PoolGrow(p);
+
+  item    = (PoolItem *)p->free;
+  p->free = item->next;
+
+  /* Update statistics */
+  p->allocs++;
+  if(++p->used > p->peak) p->peak = p->used;
+
+  memset(item, 0, p->size);
+
+  return (void *)item;
+} /* }}} */
+
+ /** subPoolFree {{{
+  * @brief Return object to pool
+  * @param[in]  p    A #SubPool
+  * @param[in]  obj  Object from this pool
+  **/
+
+void
+subPoolFree(SubPool *p,
+  void *obj)
+{
+  PoolItem *item = (PoolItem *)obj;
+
+  assert(p);
+
+  if(item)
+    {
+      item->next = p->free;
+      p->free    = item;
+
+      p->used--;
+      p->frees++;
+    }
+} /* }}} */
+
+ /** subPoolStats {{{
+  * @brief Log pool statistics
+  * @param[in]  p  A #SubPool
+  **/
+
+void
+subPoolStats(SubPool *p)
+{
+  assert(p);
+
+  subSubtleLogDebugSubtle("Stats: name=%s, used=%lu, peak=%lu, allocs=%lu, "
+    "frees=%lu, slabs=%lu, bytes=%lu\n", p->name, p->used, p->peak,
+    p->allocs, p->frees, p->nslabs,
+    p->nslabs * (sizeof(PoolSlab) + p->perslab * p->size));
+} /* }}} */
+
+ /** subPoolPublish {{{
+  * @brief Publish statistics of all pools
+  **/
+
+void
+subPoolPublish(void)
+{
+  int i;
+  long data[20] = { 0 };
+  static long last[LENGTH(data)] = { 0 };
+  SubPool *pools[] = { subtle->pools.clients, subtle->pools.trays,
+    subtle->pools.panels, subtle->pools.items };
+
+  /* Five values per pool in fixed order */
+  for(i = 0; i < LENGTH(pools); i++)
+    {
+      if(!pools[i]) continue;
+
+      data[i * 5]     = pools[i]->used;
+      data[i * 5 + 1] = pools[i]->peak;
+      data[i * 5 + 2] = pools[i]->allocs;
+      data[i * 5 + 3] = pools[i]->frees;
+      data[i * 5 + 4] = pools[i]->nslabs;
+    }
+
+  /* Skip property change when nothing happened */
+  if(0 == memcmp(data, last, sizeof(data))) return;
+
+  memcpy(last, data, sizeof(data));
+
+  subEwmhSetCardinals(ROOT, SUB_EWMH_SUBTLE_POOLS, data, LENGTH(data));
+} /* }}} */
+
+ /** subPoolKill {{{
+  * @brief Kill pool and all of its slabs
+  * @param[in]  p  A #SubPool
+  **/
+
+void
+subPoolKill(SubPool *p)
+{
+  PoolSlab *slab = NULL, *next = NULL;
+
+  assert(p);
+
+  subPoolStats(p);
+
+  for(slab = (PoolSlab *)p->slabs; slab; slab = next)
+    {
+      next = slab->next;
+
+      free(slab);
+    }
+
+  free(p);
+
+  subSubtleLogDebugSubtle("Kill\n");
+} /* }}} */
+
+// vim:ts=2:bs=2:sw=2:et:fdm=marker
@@ -11,14 +11,18 @@
   **/
 
 #include <stdarg.h>
+#include <limits.h>
 #include <unistd.h>
 #include <sys/types.h>
+#include <sys/time.h>
+#include <sys/stat.h>
 #include <dirent.h>
 #include <fnmatch.h>
 #include <fcntl.h>
 #include <ctype.h>
 #include <ruby.h>
 #include <ruby/encoding.h>
+#include <ruby/version.h>
 #include <X11/Xresource.h>
 #include "subtle.h"
 
@@ -31,12 +35,31 @@
 #define SYM2CHAR(sym)  rb_id2name(SYM2ID(sym))
 /* }}} */
 
-/* Globals {{{ */
-static VALUE shelter = Qnil, mod = Qnil, config_sublets = Qnil;
-static VALUE config_instance = Qnil, config_methods = Qnil;
-/* }}} */
-
 /* Typedef {{{ */
+typedef struct rubyclasses_t
+{
+  VALUE subtlext, client, geometry, gravity, screen, tag, view;
+} RubyClasses;
+
+typedef struct rubyids_t
+{
+  ID new, call, receiver, arity, geometry;
+  ID configure, run, data, watch, down, over, out, unload;
+} RubyIds;
+
+typedef struct rubycollector_t
+{
+  int           depth, calls;
+  VALUE         disabled;
+  unsigned long idle, steps, major, last, max, total;
+} RubyCollector;
+
+typedef struct rubyreload_t
+{
+  struct subarray_t *gravities, *tags, *views;
+  VALUE             entries, fonts;
+} RubyReload;
+
 typedef struct rubysymbol_t
 {
   VALUE sym;
@@ -50,6 +73,18 @@ typedef struct rubymethods_t
 } RubyMethods;
 /* }}} */
 
+/* Globals {{{ */
+static VALUE shelter = Qnil, mod = Qnil, config_sublets = Qnil;
+static VALUE config_instance = Qnil, config_methods = Qnil, proxies = Qnil;
+static VALUE config_digest = Qnil, config_entries = Qnil, config_fonts = Qnil;
+static RubyClasses klasses = { Qnil, Qnil, Qnil, Qnil, Qnil, Qnil, Qnil };
+static RubyIds ids;
+static SubSharedDirect direct = { subEventDirectMessage, subEventDirectProperty,
+  subRubyIconFlush };
+static RubyCollector collector = { 0, 0, Qfalse, 0, 0, 0, 0, 0, 0 };
+static RubyReload reload = { NULL, NULL, NULL, Qnil, Qnil };
+/* }}} */
+
 /* RubyBacktrace {{{ */
 static void
 RubyBacktrace(void)
@@ -99,14 +134,176 @@ RubyReceiver(unsigned long instance,
   return receiver == instance;
 } /* }}} */
 
+/* RubySubletKept {{{ */
+static int
+RubySubletKept(unsigned long meth)
+{
+  int i;
+
+  /* Check if method belongs to a kept sublet */
+  for(i = 0; i < subtle->sublets->ndata; i++)
+    {
+      SubPanel *p = PANEL(subtle->sublets->data[i]);
+
+      if(p->sublet->flags & SUB_SUBLET_KEEP &&
+          RubyReceiver(p->sublet->instance, meth))
+        return True;
+    }
+
+  return False;
+} /* }}} */
+
+/* RubySubletFind {{{ */
+static SubPanel *
+RubySubletFind(const char *path)
+{
+  int i;
+
+  /* Find sublet loaded from path */
+  for(i = 0; i < subtle->sublets->ndata; i++)
+    {
+      SubPanel *p = PANEL(subtle->sublets->data[i]);
+
+      if(p->sublet->path && 0 == strcmp(p->sublet->path, path)) return p;
+    }
+
+  return NULL;
+} /* }}} */
+
+/* RubySubletsPath {{{ */
+static int
+RubySubletsPath(char *buf,
+  size_t size)
+{
+  int len = 0;
+  char *home = NULL;
+
+  /* Check path */
+  if(subtle->paths.sublets)
+    len = snprintf(buf, size, "%s", subtle->paths.sublets);
+  else if((home = getenv("XDG_DATA_HOME")))
+    len = snprintf(buf, size, "%s/%s/sublets", home, PKG_NAME);
+  else len = snprintf(buf, size, "%s/.local/share/%s/sublets",
+    getenv("HOME"), PKG_NAME);
+
+  /* Check truncation */
+  if(0 > len || size <= (size_t)len)
+    {
+      subSubtleLogWarn("Path to sublets is too long\n");
+
+      return -1;
+    }
+
+  return len;
+} /* }}} */
+
+/* RubyGrabList {{{ */
+static VALUE
+RubyGrabList(void)
+{
+  int i;
+  VALUE list = rb_ary_new();
+
+  /* Collect chain and action of each grab */
+  for(i = 0; i < subtle->grabs->ndata; i++)
+    {
+      SubGrab *g = GRAB(subtle->grabs->data[i]);
+
+      rb_ary_push(list, rb_ary_new3(3, INT2FIX(g->code),
+        INT2FIX(g->state), LONG2NUM(g->flags)));
+    }
+
+  return rb_ary_sort_bang(list);
+} /* }}} */
+
+/* RubyReloadKeep {{{ */
+static void *
+RubyReloadKeep(SubArray *a,
+  int type,
+  VALUE name,
+  VALUE entry)
+{
+  int i;
+  VALUE key = rb_ary_new3(2, INT2FIX(type), name);
+
+  /* Only first definitions can be kept */
+  if(!NIL_P(rb_hash_lookup(config_entries, key))) return NULL;
+
+  rb_hash_aset(config_entries, key, entry);
+
+  /* Check entry of last config */
+  if(!a || NIL_P(reload.entries) ||
+      !rb_equal(rb_hash_lookup(reload.entries, key), entry))
+    return NULL;
+
+  for(i = 0; i < a->ndata; i++)
+    {
+      void *elem = a->data[i];
+
+      if((SUB_TYPE_GRAVITY == type && GRAVITY(elem)->quark ==
+          XrmStringToQuark(SYM2CHAR(name))) ||
+          (SUB_TYPE_TAG == type && 0 == strcmp(TAG(elem)->name,
+            RSTRING_PTR(name))) ||
+          (SUB_TYPE_VIEW == type && 0 == strcmp(VIEW(elem)->name,
+            RSTRING_PTR(name))))
+        {
+          subArrayRemove(a, elem);
+
+          return elem;
+        }
+    }
+
+  return NULL;
+} /* }}} */
+
+/* RubyStyleDetach {{{ */
+static void
+RubyStyleDetach(SubStyle *s)
+{
+  int i;
+
+  /* Fonts are owned by the font list now */
+  s->flags &= ~SUB_STYLE_FONT;
+
+  for(i = 0; s->styles && i < s->styles->ndata; i++)
+    RubyStyleDetach(STYLE(s->styles->data[i]));
+} /* }}} */
+
+/* RubyClientStale {{{ */
+static int
+RubyClientStale(SubClient *c)
+{
+  int i;
+  TAGS stale = c->tags;
+
+  /* Check for ids of tags created at runtime */
+  for(i = 0; i < subtle->tags->ndata; i++)
+    subSharedTagsUnset(&stale, i);
+
+  if(!subSharedTagsEmpty(&stale) ||
+      c->gravityid >= subtle->gravities->ndata)
+    return True;
+
+  /* Check for ids of gravities created at runtime */
+  for(i = 0; c->gravities && i < subtle->views->ndata; i++)
+    if(c->gravities[i] >= subtle->gravities->ndata) return True;
+
+  return False;
+} /* }}} */
+
 /* RubyFont {{{ */
 static SubFont *
 RubyFont(const char *fontname)
 {
   SubFont *f = NULL;
-
-  /* Load font */
-  if(!(f = subSharedFontNew(subtle->dpy, fontname)))
+  VALUE name = rb_str_new2(fontname), fonts = Qnil;
+
+  /* Reuse font of last config or load it */
+  if(!NIL_P(reload.fonts) &&
+      T_ARRAY == rb_type(fonts = rb_hash_lookup(reload.fonts, name)) &&
+      0 < RARRAY_LEN(fonts))
+    f = (SubFont *)NUM2ULONG(rb_ary_shift(fonts));
+  else if(!(f = subSharedFontNew(subtle->dpy, fontname)))
     {
       subSubtleLogWarn("Cannot load font `%s'\n", fontname);
 
@@ -121,11 +318,81 @@ RubyFont(const char *fontname)
         }
     }
 
+  /* Track font for next reload */
+  if(NIL_P(fonts = rb_hash_lookup(config_fonts, name)))
+    rb_hash_aset(config_fonts, name, (fonts = rb_ary_new()));
+
+  rb_ary_push(fonts, ULONG2NUM((unsigned long)f));
+
   return f;
 } /* }}} */
 
+/* RubyLoadClasses {{{ */
+static void
+RubyLoadClasses(void)
+{
+  /* Subtlext is loaded on demand, so fetch classes on first use */
+  if(NIL_P(klasses.subtlext))
+    {
+      klasses.subtlext = rb_const_get(rb_mKernel, rb_intern("Subtlext"));
+      klasses.client   = rb_const_get(klasses.subtlext, rb_intern("Client"));
+      klasses.geometry = rb_const_get(klasses.subtlext, rb_intern("Geometry"));
+      klasses.gravity  = rb_const_get(klasses.subtlext, rb_intern("Gravity"));
+      klasses.screen   = rb_const_get(klasses.subtlext, rb_intern("Screen"));
+      klasses.tag      = rb_const_get(klasses.subtlext, rb_intern("Tag"));
+      klasses.view     = rb_const_get(klasses.subtlext, rb_intern("View"));
+    }
+} /* }}} */
+
+/* RubyProxyString {{{ */
+static void
+RubyProxyString(VALUE object,
+  const char *name,
+  const char *string)
+{
+  VALUE value = rb_iv_get(object, name);
+
+  /* Just replace changed strings */
+  if(!string)
+    {
+      if(!NIL_P(value)) rb_iv_set(object, name, Qnil);
+    }
+  else if(T_STRING != rb_type(value) || strcmp(RSTRING_PTR(value), string))
+    rb_iv_set(object, name, rb_str_new2(string));
+} /* }}} */
+
+/* RubyProxyGeometry {{{ */
+static void
+RubyProxyGeometry(VALUE object,
+  XRectangle *geom)
+{
+  VALUE value = rb_iv_get(object, "@geometry");
+
+  /* Just replace changed geometries */
+  if(NIL_P(value) ||
+      FIX2INT(rb_iv_get(value, "@x"))      != geom->x     ||
+      FIX2INT(rb_iv_get(value, "@y"))      != geom->y     ||
+      FIX2INT(rb_iv_get(value, "@width"))  != geom->width ||
+      FIX2INT(rb_iv_get(value, "@height")) != geom->height)
+    {
+      value = rb_funcall(klasses.geometry, ids.new, 4, INT2FIX(geom->x),
+        INT2FIX(geom->y), INT2FIX(geom->width), INT2FIX(geom->height));
+
+      rb_iv_set(object, "@geometry", value);
+    }
+} /* }}} */
+
 /* Type converter */
 
+/* RubyTagsToValue {{{ */
+static VALUE
+RubyTagsToValue(TAGS *tags)
+{
+  /* Same bit layout as the old fixnum masks, grows to bignum */
+  return rb_integer_unpack(tags->bits, TAGSWORDS, sizeof(unsigned long), 0,
+    INTEGER_PACK_LSWORD_FIRST|INTEGER_PACK_NATIVE_BYTE_ORDER);
+} /* }}} */
+
 /* RubySubtleToSubtlext {{{ */
 static VALUE
 RubySubtleToSubtlext(void *data)
@@ -137,72 +404,70 @@ RubySubtleToSubtlext(void *data)
   if((c = CLIENT(data)))
     {
       int id = 0;
-      VALUE subtlext = Qnil, klass = Qnil;
 
-      XSync(subtle->dpy, False); ///< Sync before going on
+      XFlush(subtle->dpy); ///< Payload is taken from subtle, no need to sync
 
-      subtlext = rb_const_get(rb_mKernel, rb_intern("Subtlext"));
+      RubyLoadClasses();
 
       if(c->flags & SUB_TYPE_CLIENT) /* {{{ */
         {
           int flags = 0;
-          VALUE value = Qnil;
+          VALUE win = LONG2NUM(c->win);
+
+          /* Re-use client proxy and just refresh changed values */
+          if(NIL_P(object = rb_hash_lookup(proxies, win)))
+            {
+              object = rb_funcall(klasses.client, ids.new, 1, win);
 
-          /* Create client instance */
-          id     = subArrayIndex(subtle->clients, (void *)c);
-          klass  = rb_const_get(subtlext, rb_intern("Client"));
-          object = rb_funcall(klass, rb_intern("new"), 1, INT2FIX(id));
+              rb_iv_set(object, "__gravityid", INT2FIX(-1));
+              rb_hash_aset(proxies, win, object);
+            }
 
           /* Translate flags */
           subEwmhTranslateClientMode(c->flags, &flags);
 
           /* Set properties */
-          rb_iv_set(object, "@win",      LONG2NUM(c->win));
-          rb_iv_set(object, "@flags",    INT2FIX(flags));
-          rb_iv_set(object, "@tags",     INT2FIX(c->tags));
-          rb_iv_set(object, "@name",     rb_str_new2(c->name));
-          rb_iv_set(object, "@instance", rb_str_new2(c->instance));
-          rb_iv_set(object, "@klass",    rb_str_new2(c->klass));
-          rb_iv_set(object, "@role",     c->role ? rb_str_new2(c->role) :
-            Qnil);
-
-          /* Create and set geometry */
-          klass = rb_const_get(subtlext, rb_intern("Geometry"));
-          value = rb_funcall(klass, rb_intern("new"), 4, INT2FIX(c->geom.x),
-            INT2FIX(c->geom.y), INT2FIX(c->geom.width),
-            INT2FIX(c->geom.height));
-
-          rb_iv_set(object, "@geometry", value);
-
-          /* Create and set gravity if any */
-          if(-1 != c->gravityid)
+          rb_iv_set(object, "@win",   win);
+          rb_iv_set(object, "@flags", INT2FIX(flags));
+          rb_iv_set(object, "@tags",  RubyTagsToValue(&c->tags));
+
+          RubyProxyString(object, "@name",     c->name);
+          RubyProxyString(object, "@instance", c->instance);
+          RubyProxyString(object, "@klass",    c->klass);
+          RubyProxyString(object, "@role",     c->role);
+          RubyProxyGeometry(object, &c->geom);
+
+          /* Create and set gravity if changed */
+          if(FIX2INT(rb_iv_get(object, "__gravityid")) != c->gravityid)
             {
-              SubGravity *g = GRAVITY(subArrayGet(subtle->gravities,
-                c->gravityid));
+              VALUE value = Qnil;
 
-              klass = rb_const_get(subtlext, rb_intern("Gravity"));
-              value = rb_funcall(klass, rb_intern("new"), 1,
-                rb_str_new2(XrmQuarkToString(g->quark)));
+              if(-1 != c->gravityid)
+                {
+                  SubGravity *g = GRAVITY(subArrayGet(subtle->gravities,
+                    c->gravityid));
 
-              rb_funcall(value, rb_intern("geometry="), 4, INT2FIX(g->geom.x),
-                INT2FIX(g->geom.y), INT2FIX(g->geom.width),
-                INT2FIX(g->geom.height));
-            }
-          else value = Qnil;
+                  value = rb_funcall(klasses.gravity, ids.new, 1,
+                    rb_str_new2(XrmQuarkToString(g->quark)));
 
-          rb_iv_set(object, "@gravity", value);
+                  rb_funcall(value, ids.geometry, 4, INT2FIX(g->geom.x),
+                    INT2FIX(g->geom.y), INT2FIX(g->geom.width),
+                    INT2FIX(g->geom.height));
+                }
+
+              rb_iv_set(object, "@gravity",    value);
+              rb_iv_set(object, "__gravityid", INT2FIX(c->gravityid));
+            }
         } /* }}} */
       else if(c->flags & SUB_TYPE_SCREEN) /* {{{ */
         {
           SubScreen *s = SCREEN(c);
-          VALUE klass_geom, geom = Qnil;
+          VALUE geom = Qnil;
 
           /* Create tag instance */
-          id         = subArrayIndex(subtle->screens, (void *)s);
-          klass      = rb_const_get(subtlext, rb_intern("Screen"));
-          klass_geom = rb_const_get(subtlext, rb_intern("Geometry"));
-          object     = rb_funcall(klass, rb_intern("new"), 1, INT2FIX(id));
-          geom       = rb_funcall(klass_geom, rb_intern("new"), 4,
+          id     = subArrayIndex(subtle->screens, (void *)s);
+          object = rb_funcall(klasses.screen, ids.new, 1, INT2FIX(id));
+          geom   = rb_funcall(klasses.geometry, ids.new, 4,
             INT2FIX(s->geom.x), INT2FIX(s->geom.y),
             INT2FIX(s->geom.width), INT2FIX(s->geom.height));
 
@@ -215,8 +480,7 @@ RubySubtleToSubtlext(void *data)
 
           /* Create tag instance */
           id     = subArrayIndex(subtle->tags, (void *)t);
-          klass  = rb_const_get(subtlext, rb_intern("Tag"));
-          object = rb_funcall(klass, rb_intern("new"), 1, rb_str_new2(t->name));
+          object = rb_funcall(klasses.tag, ids.new, 1, rb_str_new2(t->name));
 
           /* Set properties */
           rb_iv_set(object, "@id", INT2FIX(id));
@@ -227,18 +491,54 @@ RubySubtleToSubtlext(void *data)
 
           /* Create view instance */
           id     = subArrayIndex(subtle->views, (void *)v);
-          klass  = rb_const_get(subtlext, rb_intern("View"));
-          object = rb_funcall(klass, rb_intern("new"), 1, rb_str_new2(v->name));
+          object = rb_funcall(klasses.view, ids.new, 1, rb_str_new2(v->name));
 
           /* Set properties */
           rb_iv_set(object, "@id",   INT2FIX(id));
-          rb_iv_set(object, "@tags", INT2FIX(v->tags));
+          rb_iv_set(object, "@tags", RubyTagsToValue(&v->tags));
         } /* }}} */
     }
 
   return object;
 } /* }}} */
 
+/* RubyDeltaToHash {{{ */
+static VALUE
+RubyDeltaToHash(SubDelta *d)
+{
+  int i, j;
+  const char *keys[] = { "added", "moved", "shown", "hidden" };
+  SubArray *arrays[] = { d->added, d->moved, d->shown, d->hidden };
+  VALUE hash = rb_hash_new(), ary = Qnil;
+
+  /* Changed clients */
+  for(i = 0; i < LENGTH(keys); i++)
+    {
+      ary = rb_ary_new();
+
+      if(arrays[i])
+        {
+          for(j = 0; j < arrays[i]->ndata; j++)
+            rb_ary_push(ary, RubySubtleToSubtlext(arrays[i]->data[j]));
+        }
+
+      rb_hash_aset(hash, CHAR2SYM(keys[i]), ary);
+    }
+
+  /* Removed windows are gone, just pass ids */
+  ary = rb_ary_new();
+
+  if(d->removed)
+    {
+      for(j = 0; j < d->removed->ndata; j++)
+        rb_ary_push(ary, LONG2NUM((Window)d->removed->data[j]));
+    }
+
+  rb_hash_aset(hash, CHAR2SYM("removed"), ary);
+
+  return hash;
+} /* }}} */
+
 /* RubyIconToIcon {{{ */
 static void
 RubyIconToIcon(VALUE icon,
@@ -550,7 +850,8 @@ RubyHashToSides(VALUE params,
 /* RubyEvalHook {{{ */
 static void
 RubyEvalHook(VALUE event,
-  VALUE proc)
+  VALUE proc,
+  SubTag *filter)
 {
   int i;
   SubHook *h = NULL;
@@ -580,16 +881,33 @@ RubyEvalHook(VALUE event,
     {
       if(hooks[i].sym == event)
         {
+          /* Filters need a client to match */
+          if(filter && !(hooks[i].flags & SUB_HOOK_TYPE_CLIENT))
+            {
+              subSubtleLogWarn("Cannot filter hook `%s'\n", SYM2CHAR(event));
+
+              break;
+            }
+
           /* Create new hook */
-          if((h = subHookNew(hooks[i].flags, proc)))
+          if((h = subHookNew(hooks[i].flags, proc, filter)))
             {
               subArrayPush(subtle->hooks, (void *)h);
               rb_ary_push(shelter, proc); ///< Protect from GC
             }
 
-          break;
+          return;
         }
     }
+
+  /* Remove unused filter */
+  if(filter)
+    {
+      subTagMatcherClear(filter);
+
+      free(filter->name);
+      free(filter);
+    }
 } /* }}} */
 
 /* RubyEvalGrab {{{ */
@@ -927,7 +1245,7 @@ RubyEvalPanel(VALUE ary,
                 {
                   /* Add dummy panel as entry point for sublets */
                   flags |= SUB_PANEL_SUBLETS;
-                  p      = PANEL(subSharedMemoryAlloc(1, sizeof(SubPanel)));
+                  p      = PANEL(subPoolAlloc(subtle->pools.panels));
                 }
             }
           else if(entry == tray)
@@ -1125,8 +1443,8 @@ RubyEvalConfig(void)
     {
       subSubtleLogWarn("Cannot find any tags\n");
     }
-  else if(32 < subtle->tags->ndata)
-    subSubtleLogWarn("Cannot handle more than 32 tags\n");
+  else if(TAGSMAX < subtle->tags->ndata)
+    subSubtleLogWarn("Cannot handle more than %d tags\n", TAGSMAX);
 
   /* Check and update views */
   if(0 == subtle->views->ndata) ///< Create default view
@@ -1142,13 +1460,14 @@ RubyEvalConfig(void)
 
       /* Check for view with default tag */
       for(i = subtle->views->ndata - 1; 0 <= i; i--)
-        if((v = VIEW(subtle->views->data[i])) && v->tags & DEFAULTTAG)
+        if((v = VIEW(subtle->views->data[i])) &&
+            subSharedTagsTest(&v->tags, DEFAULTTAG))
           {
             subSubtleLogDebugRuby("EvalConfig: default view=%s\n", v->name);
             break;
           }
 
-      v->tags |= DEFAULTTAG; ///< Set default tag
+      subSharedTagsSet(&v->tags, DEFAULTTAG); ///< Set default tag
     }
 
   subViewPublish();
@@ -1326,6 +1645,25 @@ RubyForeachMatcher(VALUE key,
   return ST_CONTINUE;
 } /* }}} */
 
+/* RubyForeachFont {{{ */
+static int
+RubyForeachFont(VALUE key,
+  VALUE value,
+  VALUE extra)
+{
+  int i;
+
+  /* Kill fonts and drop glyphs of them */
+  for(i = 0; i < RARRAY_LEN(value); i++)
+    {
+      subSharedFontKill(subtle->dpy,
+        (SubFont *)NUM2ULONG(rb_ary_entry(value, i)));
+      subTextFlush();
+    }
+
+  return ST_CONTINUE;
+} /* }}} */
+
 /* RubyForeachStyle {{{ */
 static int
 RubyForeachStyle(VALUE key,
@@ -1379,6 +1717,17 @@ RubyWrapLoadSubtlext(VALUE data)
   return rb_require("subtle/subtlext");
 }/* }}} */
 
+/* RubyWrapMatcher {{{ */
+static VALUE
+RubyWrapMatcher(VALUE data)
+{
+  VALUE *rargs = (VALUE *)data;
+
+  rb_hash_foreach(rargs[2], RubyForeachMatcher, data);
+
+  return Qnil;
+} /* }}} */
+
 /* RubyWrapLoadPanels {{{ */
 static VALUE
 RubyWrapLoadPanels(VALUE data)
@@ -1421,6 +1770,7 @@ RubyWrapLoadPanels(VALUE data)
                   pos = j;
 
                   subArrayRemove(s->panels, (void *)p);
+                  s->flags |= SUB_SCREEN_REFLOW; ///< Force layout
 
                   /* Find sublets not on any panel so far */
                   for(k = 0; k < subtle->sublets->ndata; k++)
@@ -1454,7 +1804,7 @@ RubyWrapLoadPanels(VALUE data)
                         sublet->flags &= ~SUB_PANEL_SEPARATOR2;
                     }
 
-                  free(p);
+                  subPoolFree(subtle->pools.panels, p);
 
                   break;
                 }
@@ -1481,23 +1831,23 @@ RubyWrapLoadPanels(VALUE data)
 static VALUE
 RubyWrapCall(VALUE data)
 {
-  VALUE *rargs = (VALUE *)data;
+  VALUE *rargs = (VALUE *)data, arg = Qnil;
 
   /* Check call type */
   switch((int)rargs[0])
     {
       case SUB_CALL_CONFIGURE: /* {{{ */
-        rb_funcall(rargs[1], rb_intern("__configure"), 1, rargs[1]);
+        rb_funcall(rargs[1], ids.configure, 1, rargs[1]);
         break; /* }}} */
       case SUB_CALL_RUN: /* {{{ */
-        rb_funcall(rargs[1], rb_intern("__run"), 1, rargs[1]);
+        rb_funcall(rargs[1], ids.run, 1, rargs[1]);
         break; /* }}} */
       case SUB_CALL_DATA: /* {{{ */
           {
             int nlist = 0;
             char **list = NULL;
             Atom prop = subEwmhGet(SUB_EWMH_SUBTLE_DATA);
-            VALUE meth = rb_intern("__data"), str = Qnil;
+            VALUE str = Qnil;
 
             /* Fetch data or create empty string */
             if((list = subSharedPropertyGetStrings(subtle->dpy, ROOT,
@@ -1513,34 +1863,39 @@ RubyWrapCall(VALUE data)
             subSharedPropertyDelete(subtle->dpy, ROOT, prop);
 
             /* Finally call method */
-            rb_funcall(rargs[1], meth,
-              MINMAX(rb_obj_method_arity(rargs[1], meth), 1, 2),
+            rb_funcall(rargs[1], ids.data,
+              MINMAX(rb_obj_method_arity(rargs[1], ids.data), 1, 2),
               rargs[1], str);
           }
         break; /* }}} */
       case SUB_CALL_WATCH: /* {{{ */
-        rb_funcall(rargs[1], rb_intern("__watch"), 1, rargs[1]);
+        rb_funcall(rargs[1], ids.watch, 1, rargs[1]);
         break; /* }}} */
       case SUB_CALL_DOWN: /* {{{ */
           {
             int *args = (int *)rargs[2];
-            VALUE meth = rb_intern("__down");
 
-            rb_funcall(rargs[1], meth,
-              MINMAX(rb_obj_method_arity(rargs[1], meth), 1, 4),
+            rb_funcall(rargs[1], ids.down,
+              MINMAX(rb_obj_method_arity(rargs[1], ids.down), 1, 4),
               rargs[1], INT2FIX(args[0]), INT2FIX(args[1]), INT2FIX(args[2]));
           }
         break; /* }}} */
       case SUB_CALL_OVER: /* {{{ */
-        rb_funcall(rargs[1], rb_intern("__over"), 1, rargs[1]);
+        rb_funcall(rargs[1], ids.over, 1, rargs[1]);
         break; /* }}} */
       case SUB_CALL_OUT: /* {{{ */
-        rb_funcall(rargs[1], rb_intern("__out"), 1, rargs[1]);
+        rb_funcall(rargs[1], ids.out, 1, rargs[1]);
         break; /* }}} */
       case SUB_CALL_UNLOAD: /* {{{ */
-        rb_funcall(rargs[1], rb_intern("__unload"), 1, rargs[1]);
+        rb_funcall(rargs[1], ids.unload, 1, rargs[1]);
         break; /* }}} */
-      default: /* {{{ */
+      case SUB_CALL_TILE: /* {{{ */
+      default:
+        /* Convert payload for hooks */
+        if(SUB_CALL_TILE == (int)rargs[0])
+          arg = RubyDeltaToHash(DELTA(rargs[2]));
+        else arg = RubySubtleToSubtlext((VALUE *)rargs[2]);
+
         /* Call instance methods or just a proc */
         if(rb_obj_is_instance_of(rargs[1], rb_cMethod))
           {
@@ -1548,22 +1903,19 @@ RubyWrapCall(VALUE data)
             VALUE receiver = Qnil;
 
             /* Get arity */
-            receiver = rb_funcall(rargs[1], rb_intern("receiver"), 0, NULL);
-            arity    = FIX2INT(rb_funcall(rargs[1], rb_intern("arity"),
-              0, NULL));
+            receiver = rb_funcall(rargs[1], ids.receiver, 0, NULL);
+            arity    = FIX2INT(rb_funcall(rargs[1], ids.arity, 0, NULL));
             arity    = -1 == arity ? 2 : MINMAX(arity, 1, 2);
 
-            rb_funcall(rargs[1], rb_intern("call"), arity, receiver,
-              RubySubtleToSubtlext((VALUE *)rargs[2]));
+            rb_funcall(rargs[1], ids.call, arity, receiver, arg);
 
             subScreenUpdate();
             subScreenRender();
           }
         else
           {
-            rb_funcall(rargs[1], rb_intern("call"),
-              MINMAX(rb_proc_arity(rargs[1]), 0, 1),
-              RubySubtleToSubtlext((VALUE *)rargs[2]));
+            rb_funcall(rargs[1], ids.call,
+              MINMAX(rb_proc_arity(rargs[1]), 0, 1), arg);
           }
         break; /* }}} */
     }
@@ -1582,11 +1934,131 @@ RubyWrapRelease(VALUE value)
   return Qnil;
 } /* }}} */
 
+/* RubyWrapCacheLoad {{{ */
+static VALUE
+RubyWrapCacheLoad(VALUE data)
+{
+  VALUE *rargs = (VALUE *)data, bin = Qnil, meta = Qnil;
+
+  /* Load binary if it was compiled from the same source */
+  bin  = rb_funcall(rb_cFile, rb_intern("binread"), 1, rargs[1]);
+  meta = rb_funcall(rargs[0], rb_intern("load_from_binary_extra_data"),
+    1, bin);
+
+  if(rb_equal(meta, rargs[2]))
+    return rb_funcall(rargs[0], rb_intern("load_from_binary"), 1, bin);
+
+  return Qnil;
+} /* }}} */
+
+/* RubyWrapCacheStore {{{ */
+static VALUE
+RubyWrapCacheStore(VALUE data)
+{
+  VALUE *rargs = (VALUE *)data, bin = Qnil;
+
+  bin = rb_funcall(rargs[0], rb_intern("to_binary"), 1, rargs[2]);
+  rb_funcall(rb_cFile, rb_intern("binwrite"), 2, rargs[1], bin);
+
+  return Qnil;
+} /* }}} */
+
+/* RubyWrapCacheCompile {{{ */
+static VALUE
+RubyWrapCacheCompile(VALUE data)
+{
+  VALUE *rargs = (VALUE *)data;
+
+  return rb_funcall(rargs[0], rb_intern("compile_file"), 1, rargs[3]);
+} /* }}} */
+
+/* RubyWrapCompile {{{ */
+static VALUE
+RubyWrapCompile(VALUE file)
+{
+  int state = 0;
+  unsigned long hash = 2166136261UL;
+  char *home = NULL, *c = NULL, buf[255] = { 0 };
+  struct stat st;
+  VALUE klass = Qnil, iseq = Qnil, rargs[4] = { Qnil };
+
+  /* Check if bytecode can be stored */
+  if(!rb_const_defined(rb_cObject, rb_intern("RubyVM")) ||
+      !rb_const_defined(rb_const_get(rb_cObject, rb_intern("RubyVM")),
+        rb_intern("InstructionSequence")) ||
+      -1 == stat(RSTRING_PTR(file), &st))
+    return Qnil;
+
+  klass = rb_const_get(rb_const_get(rb_cObject, rb_intern("RubyVM")),
+    rb_intern("InstructionSequence"));
+
+  if(!rb_respond_to(klass, rb_intern("load_from_binary"))) return Qnil;
+
+  /* Create cache dir on demand */
+  if((home = getenv("XDG_CACHE_HOME")))
+    snprintf(buf, sizeof(buf), "%s", home);
+  else snprintf(buf, sizeof(buf), "%s/.cache", getenv("HOME"));
+
+  mkdir(buf, 0700);
+  snprintf(buf + strlen(buf), sizeof(buf) - strlen(buf), "/%s", PKG_NAME);
+  mkdir(buf, 0700);
+
+  /* Name cache file after path and check source via meta data */
+  for(c = RSTRING_PTR(file); *c; c++)
+    hash = (hash ^ (unsigned char)*c) * 16777619UL;
+
+  snprintf(buf + strlen(buf), sizeof(buf) - strlen(buf),
+    "/%08lx.iseq", hash & 0xffffffffUL);
+
+  rargs[0] = klass;
+  rargs[1] = rb_str_new2(buf);
+  rargs[2] = rb_sprintf("%ld:%ld:%s:%s:%s", (long)st.st_mtime,
+    (long)st.st_size, ruby_version, RUBY_PLATFORM, RSTRING_PTR(file));
+  rargs[3] = file;
+
+  if(-1 != access(buf, R_OK))
+    {
+      iseq = rb_protect(RubyWrapCacheLoad, (VALUE)&rargs, &state);
+      if(state) iseq = Qnil; ///< Just recompile
+    }
+
+  /* Compile the plain file, errors are left to the uncached eval */
+  if(NIL_P(iseq))
+    {
+      iseq = rb_protect(RubyWrapCacheCompile, (VALUE)&rargs, &state);
+      if(state)
+        {
+          rb_set_errinfo(Qnil);
+
+          return Qnil;
+        }
+
+      rargs[0] = iseq;
+      rb_protect(RubyWrapCacheStore, (VALUE)&rargs, &state);
+      if(state) rb_set_errinfo(Qnil); ///< Cache is optional
+
+      subSubtleLogDebugRuby("Compile: file=%s, cache=%s\n",
+        RSTRING_PTR(file), buf);
+    }
+
+  return iseq;
+} /* }}} */
+
 /* RubyWrapEvalFile {{{ */
 static VALUE
 RubyWrapEvalFile(VALUE data)
 {
-  VALUE *rargs = (VALUE *)data, rargs2[3] = { Qnil };
+  VALUE *rargs = (VALUE *)data, rargs2[3] = { Qnil }, iseq = Qnil;
+
+  /* Eval cached bytecode on top level if possible, DSL calls of main
+   * are forwarded to the config instance */
+  if(config_instance == rargs[1] &&
+      !NIL_P(iseq = RubyWrapCompile(rargs[0])))
+    {
+      rb_funcall(iseq, rb_intern("eval"), 0, NULL);
+
+      return Qnil;
+    }
 
   /* Wrap data */
   rargs2[0] = rb_funcall(rb_cFile, rb_intern("read"), 1, rargs[0]);
@@ -1667,6 +2139,23 @@ RubyObjectDispatcher(VALUE self,
   return ret;
 } /* }}} */
 
+/* RubyMainDispatcher {{{ */
+/*
+ * Dispatcher for DSL calls on top level - internal use only
+ */
+
+static VALUE
+RubyMainDispatcher(int argc,
+  VALUE *argv,
+  VALUE self)
+{
+  /* Forward to config instance like instance_eval did */
+  if(NIL_P(config_instance)) return rb_call_super(argc, argv);
+
+  return rb_funcall_passing_block(config_instance,
+    rb_to_id(argv[0]), argc - 1, argv + 1);
+} /* }}} */
+
 /* Options */
 
 /* RubyOptionsInit {{{ */
@@ -1945,6 +2434,11 @@ RubyConfigSet(VALUE self,
                 if(!(subtle->flags & SUB_SUBTLE_CHECK))
                   subtle->gravity = value; ///< Store for later
               }
+            else if(CHAR2SYM("panel_fps") == option)
+              {
+                if(!(subtle->flags & SUB_SUBTLE_CHECK))
+                  subtle->fps = MINMAX(FIX2INT(value), 0, 1000);
+              }
             else subSubtleLogWarn("Unknown option `:%s'\n", SYM2CHAR(option));
             break; /* }}} */
           case T_SYMBOL: /* {{{ */
@@ -1991,6 +2485,11 @@ RubyConfigSet(VALUE self,
                 if(!(subtle->flags & SUB_SUBTLE_CHECK) && Qtrue == value)
                   subtle->flags |= SUB_SUBTLE_SKIP_URGENT_WARP;
               }
+            else if(CHAR2SYM("client_snap") == option)
+              {
+                if(!(subtle->flags & SUB_SUBTLE_CHECK) && Qtrue == value)
+                  subtle->flags |= SUB_SUBTLE_CLIENT_SNAP;
+              }
             else subSubtleLogWarn("Unknown option `:%s'\n", SYM2CHAR(option));
             break; /* }}} */
           case T_STRING: /* {{{ */
@@ -2037,10 +2536,13 @@ RubyConfigGravity(int argc,
   VALUE *argv,
   VALUE self)
 {
-  VALUE name = Qnil, value = Qnil, tile = Qnil;
+  VALUE name = Qnil, value = Qnil, tile = Qnil, item = Qnil;
 
   rb_scan_args(argc, argv, "21", &name, &value, &tile);
 
+  item = rb_ary_new4(argc, argv);
+  rb_ary_push(config_digest, item); ///< Track changes
+
   /* Check value type */
   if(T_SYMBOL == rb_type(name) && T_ARRAY == rb_type(value))
     {
@@ -2053,8 +2555,11 @@ RubyConfigGravity(int argc,
         {
           SubGravity *g = NULL;
 
-          /* Finally create new gravity */
-          if((g = subGravityNew(SYM2CHAR(name), &geometry)))
+          /* Keep unchanged gravity or create new one */
+          if((g = RubyReloadKeep(reload.gravities, SUB_TYPE_GRAVITY,
+              name, item)))
+            subArrayPush(subtle->gravities, (void *)g);
+          else if((g = subGravityNew(SYM2CHAR(name), &geometry)))
             {
               /* Tile just clients with this gravity */
               if(T_SYMBOL == rb_type(tile))
@@ -2121,6 +2626,7 @@ RubyConfigTag(int argc,
   unsigned long gravityid = 0;
   XRectangle geom = { 0 };
   VALUE name = Qnil, match = Qnil, params = Qnil, value = Qnil, proc = Qnil;
+  VALUE item = Qnil;
 
   rb_scan_args(argc, argv, "11", &name, &match);
 
@@ -2203,6 +2709,10 @@ RubyConfigTag(int argc,
       if(Qtrue == (value = rb_hash_lookup(params,
         CHAR2SYM("zaphod")))) flags |= SUB_CLIENT_MODE_ZAPHOD;
 
+      /* Check live retag */
+      if(Qtrue == (value = rb_hash_lookup(params,
+        CHAR2SYM("retag")))) flags |= SUB_TAG_RETAG;
+
       /* Set stick screen */
       if(RTEST(value = rb_hash_lookup(params, CHAR2SYM("stick"))))
         {
@@ -2225,6 +2735,9 @@ RubyConfigTag(int argc,
         }
     }
 
+  item = rb_ary_new3(3, name, match, params);
+  rb_ary_push(config_digest, item); ///< Track changes
+
   /* Check value type */
   if(T_STRING == rb_type(name))
     {
@@ -2234,8 +2747,19 @@ RubyConfigTag(int argc,
           int duplicate = False;
           SubTag *t = NULL;
 
-          /* Finally create and add new tag if no duplicate */
-          if((t = subTagNew(RSTRING_PTR(name), &duplicate)) &&
+          /* Keep unchanged tag, lazy values are evaluated again */
+          if(!subSubtleFind((Window)XrmStringToQuark(RSTRING_PTR(name)),
+              TAGID) && (t = RubyReloadKeep(reload.tags, SUB_TYPE_TAG,
+              name, item)))
+            {
+              t->flags     |= flags;
+              t->gravityid  = gravityid;
+
+              XSaveContext(subtle->dpy, (XID)XrmStringToQuark(t->name),
+                TAGID, (void *)t);
+              subArrayPush(subtle->tags, (void *)t);
+            }
+          else if((t = subTagNew(RSTRING_PTR(name), &duplicate)) &&
               False == duplicate)
             {
               int i;
@@ -2288,8 +2812,10 @@ RubyConfigView(int argc,
   VALUE *argv,
   VALUE self)
 {
-  int flags = 0;
+  int flags = 0, layoutid = -1, master = 1;
+  double ratio = 0.5;
   VALUE name = Qnil, match = Qnil, params = Qnil, value = Qnil, icon = value;
+  VALUE item = Qnil;
 
   rb_scan_args(argc, argv, "11", &name, &match);
 
@@ -2321,8 +2847,39 @@ RubyConfigView(int argc,
 
       /* Check icon */
       icon = RubyValueToIcon(rb_hash_lookup(params, CHAR2SYM("icon")));
+
+      /* Check layout and its params */
+      if(!NIL_P(value = rb_hash_lookup(params, CHAR2SYM("layout"))))
+        {
+          VALUE lparams = Qnil, entry = Qnil;
+
+          if(T_ARRAY == rb_type(value))
+            {
+              lparams = rb_ary_entry(value, 1);
+              value   = rb_ary_entry(value, 0);
+            }
+
+          if(T_SYMBOL == rb_type(value))
+            {
+              if(-1 == (layoutid = subLayoutFind(SYM2CHAR(value))))
+                subSubtleLogWarn("Cannot find layout `%s'\n", SYM2CHAR(value));
+            }
+
+          if(T_HASH == rb_type(lparams))
+            {
+              if(FIXNUM_P(entry = rb_hash_lookup(lparams, CHAR2SYM("master"))))
+                master = FIX2INT(entry);
+
+              entry = rb_hash_lookup(lparams, CHAR2SYM("ratio"));
+              if(FIXNUM_P(entry) || T_FLOAT == rb_type(entry))
+                ratio = NUM2DBL(entry);
+            }
+        }
     }
 
+  item = rb_ary_new3(3, name, match, params);
+  rb_ary_push(config_digest, item); ///< Track changes
+
   /* Check value type */
   if(T_STRING == rb_type(name))
     {
@@ -2342,13 +2899,29 @@ RubyConfigView(int argc,
                 break;
             }
 
-          /* Finally create new view */
-          if((v = subViewNew(RSTRING_PTR(name), re)))
+          /* Keep unchanged view but match tags again */
+          if((v = RubyReloadKeep(reload.views, SUB_TYPE_VIEW, name, item)))
+            {
+              v->styleid = -1;
+
+              subViewTags(v, re);
+              subArrayPush(subtle->views, (void *)v);
+            }
+          else if((v = subViewNew(RSTRING_PTR(name), re)))
             {
               v->flags |= flags;
 
               subArrayPush(subtle->views, (void *)v);
 
+              /* Set layout */
+              if(-1 != layoutid)
+                {
+                  v->flags    |= SUB_VIEW_LAYOUT;
+                  v->layoutid  = layoutid;
+                  v->master    = MAX(master, 1);
+                  v->ratio     = MINMAX(ratio, 0.1, 0.9);
+                }
+
               /* Add icon */
               if(!NIL_P(icon))
                 {
@@ -2370,13 +2943,18 @@ RubyConfigView(int argc,
 
 /* RubyConfigOn {{{ */
 /*
- * call-seq: on(event, &block) -> nil
+ * call-seq: on(event, &block)          -> nil
+ *           on(event, filter, &block)  -> nil
  *
- * Event block for hooks
+ * Event block for hooks, client hooks can be filtered in advance
  *
  *  on :event do |s|
  *    puts s.name
  *  end
+ *
+ *  on :client_create, class: /term/ do |c|
+ *    puts c.name
+ *  end
  */
 
 static VALUE
@@ -2384,6 +2962,7 @@ RubyConfigOn(int argc,
   VALUE *argv,
   VALUE self)
 {
+  SubTag *filter = NULL;
   VALUE event = Qnil, value = Qnil;
 
   rb_scan_args(argc, argv, "11", &event, &value);
@@ -2393,9 +2972,31 @@ RubyConfigOn(int argc,
     {
       if(subtle->flags & SUB_SUBTLE_CHECK) return Qnil; ///< Skip on check
 
-      if(rb_block_given_p()) value = rb_block_proc(); ///< Get proc
+      if(rb_block_given_p())
+        {
+          /* Compile client filter */
+          if(T_HASH == rb_type(value))
+            {
+              int state = 0;
+              VALUE rargs[3] = { Qnil, 0, Qnil };
+
+              filter   = subTagNew("hook", NULL);
+              rargs[0] = (VALUE)filter;
+              rargs[2] = value;
 
-      RubyEvalHook(event, value);
+              /* Don't leak filter on invalid matchers */
+              rb_protect(RubyWrapMatcher, (VALUE)&rargs, &state);
+              if(state)
+                {
+                  subTagKill(filter);
+                  rb_jump_tag(state);
+                }
+            }
+
+          value = rb_block_proc(); ///< Get proc
+        }
+
+      RubyEvalHook(event, value, filter);
     }
   else rb_raise(rb_eArgError, "Unknown value type for on");
 
@@ -2875,7 +3476,7 @@ RubySubletOn(VALUE self,
           rb_funcall(sing, meth, 2, CHAR2SYM(buf), proc);
 
           RubyEvalHook(event, rb_obj_method(p->sublet->instance,
-            CHAR2SYM(buf)));
+            CHAR2SYM(buf)), NULL);
         }
     }
   else rb_raise(rb_eArgError, "Unknown value type for on");
@@ -2954,7 +3555,7 @@ RubySubletRender(VALUE self)
   SubPanel *p = NULL;
 
   Data_Get_Struct(self, SubPanel, p);
-  if(p) subScreenRender();
+  if(p) subScreenSchedule();
 
   return Qnil;
 } /* }}} */
@@ -3483,6 +4084,11 @@ subRubyInit(void)
 
   rb_define_singleton_method(rb_cObject, "const_missing", RubyObjectDispatcher, 1);
 
+  /* Top level of cached config files */
+  rb_define_singleton_method(rb_funcall(rb_const_get(rb_cObject,
+    rb_intern("TOPLEVEL_BINDING")), rb_intern("receiver"), 0, NULL),
+    "method_missing", RubyMainDispatcher, -1);
+
   /*
    * Document-class: Subtle
    *
@@ -3491,6 +4097,10 @@ subRubyInit(void)
 
   mod = rb_define_module("Subtle");
 
+  /* Hand direct handlers over to subtlext */
+  rb_ivar_set(mod, rb_intern("__direct"), Data_Wrap_Struct(rb_cObject,
+    NULL, NULL, (void *)&direct));
+
   /*
    * Document-class: Config
    *
@@ -3569,6 +4179,25 @@ subRubyInit(void)
   shelter = rb_ary_new();
   rb_gc_register_address(&shelter);
 
+  /* Client proxies for hooks */
+  proxies = rb_hash_new();
+  rb_gc_register_address(&proxies);
+
+  /* Cache method ids */
+  ids.new       = rb_intern("new");
+  ids.call      = rb_intern("call");
+  ids.receiver  = rb_intern("receiver");
+  ids.arity     = rb_intern("arity");
+  ids.geometry  = rb_intern("geometry=");
+  ids.configure = rb_intern("__configure");
+  ids.run       = rb_intern("__run");
+  ids.data      = rb_intern("__data");
+  ids.watch     = rb_intern("__watch");
+  ids.down      = rb_intern("__down");
+  ids.over      = rb_intern("__over");
+  ids.out       = rb_intern("__out");
+  ids.unload    = rb_intern("__unload");
+
   subSubtleLogDebugSubtle("Init\n");
 } /* }}} */
 
@@ -3580,12 +4209,13 @@ subRubyInit(void)
 void
 subRubyLoadConfig(void)
 {
+  int duplicate = False;
   VALUE klass = Qnil;
   SubTag *t = NULL;
 
   /* Create default tag */
   if(!(subtle->flags & SUB_SUBTLE_CHECK) &&
-      (t = subTagNew("default", NULL)))
+      (t = subTagNew("default", &duplicate)) && !duplicate)
     subArrayPush(subtle->tags, (void *)t);
 
   /* Reset styles */
@@ -3609,8 +4239,14 @@ subRubyLoadConfig(void)
   /* Create and register config values */
   config_sublets = rb_hash_new();
   config_methods = rb_ary_new();
+  config_digest  = rb_ary_new();
+  config_entries = rb_hash_new();
+  config_fonts   = rb_hash_new();
   rb_gc_register_address(&config_sublets);
   rb_gc_register_address(&config_methods);
+  rb_gc_register_address(&config_digest);
+  rb_gc_register_address(&config_entries);
+  rb_gc_register_address(&config_fonts);
 
   /* Load supplied config or default */
   klass           = rb_const_get(mod, rb_intern("Config"));
@@ -3642,31 +4278,66 @@ subRubyLoadConfig(void)
 void
 subRubyReloadConfig(void)
 {
-  int i, rx = 0, ry = 0, x = 0, y = 0, *vids = NULL;
+  int i, j, rx = 0, ry = 0, x = 0, y = 0, *vids = NULL, changed = False;
   unsigned int mask = 0;
   Window root = None, win = None;
   SubClient *c = NULL;
+  VALUE sublets = Qnil, digest = Qnil, grabs = Qnil;
 
-  /* Reset panel height */
-  subtle->ph = 0;
+  /* Reset panel height and refresh rate */
+  subtle->ph  = 0;
+  subtle->fps = 0;
 
   /* Reset flags before reloading */
   subtle->flags &= (SUB_SUBTLE_DEBUG|SUB_SUBTLE_EWMH|SUB_SUBTLE_RUN|
     SUB_SUBTLE_XINERAMA|SUB_SUBTLE_XRANDR|SUB_SUBTLE_URGENT);
 
+  /* Drop colorized icons and client proxies */
+  subSharedDrawIconFlush(subtle->dpy, None);
+  rb_hash_clear(proxies);
+
+  /* Keep old config values for comparison */
+  sublets        = config_sublets;
+  digest         = config_digest;
+  grabs          = RubyGrabList();
+  reload.entries = config_entries;
+  reload.fonts   = config_fonts;
+
+  rb_gc_register_address(&reload.entries);
+  rb_gc_register_address(&reload.fonts);
+
   /* Unregister config values */
   rb_gc_unregister_address(&config_sublets);
   rb_gc_unregister_address(&config_instance);
   rb_gc_unregister_address(&config_methods);
-
-  /* Reset sublet panel flags */
+  rb_gc_unregister_address(&config_digest);
+  rb_gc_unregister_address(&config_entries);
+  rb_gc_unregister_address(&config_fonts);
+
+  /* Hand style fonts over to the font list for reuse */
+  RubyStyleDetach(&subtle->styles.all);
+  RubyStyleDetach(&subtle->styles.views);
+  RubyStyleDetach(&subtle->styles.title);
+  RubyStyleDetach(&subtle->styles.sublets);
+  RubyStyleDetach(&subtle->styles.separator);
+  RubyStyleDetach(&subtle->styles.clients);
+  RubyStyleDetach(&subtle->styles.subtle);
+
+  /* Reset sublet panel flags and keep sublets with unchanged source */
   for(i = 0; i < subtle->sublets->ndata; i++)
     {
+      struct stat st;
       SubPanel *p = PANEL(subtle->sublets->data[i]);
 
       p->flags &= ~(SUB_PANEL_BOTTOM|SUB_PANEL_SPACER1|
-        SUB_PANEL_SPACER1| SUB_PANEL_SEPARATOR1|SUB_PANEL_SEPARATOR2);
+        SUB_PANEL_SPACER1| SUB_PANEL_SEPARATOR1|SUB_PANEL_SEPARATOR2|
+        SUB_PANEL_PLACED);
       p->screen = NULL;
+
+      if(p->sublet->path && 0 == stat(p->sublet->path, &st) &&
+          st.st_mtime == p->sublet->mtime && st.st_size == p->sublet->size)
+        p->sublet->flags |= SUB_SUBLET_KEEP;
+      else p->sublet->flags &= ~SUB_SUBLET_KEEP;
     }
 
   /* Allocate memory to store current views per screen */
@@ -3680,19 +4351,117 @@ subRubyReloadConfig(void)
       vids[i]   = s->viewid; ///< Store views
       s->flags &= ~(SUB_SCREEN_STIPPLE|SUB_SCREEN_PANEL1|SUB_SCREEN_PANEL2);
 
+      /* Take kept sublets out before killing the others */
+      for(j = 0; j < s->panels->ndata; j++)
+        {
+          SubPanel *p = PANEL(s->panels->data[j]);
+
+          if(p->flags & SUB_PANEL_SUBLET && !(p->flags & SUB_PANEL_COPY) &&
+              p->sublet->flags & SUB_SUBLET_KEEP)
+            {
+              subArrayRemove(s->panels, (void *)p);
+              j--; ///< Prevent skipping of entries
+            }
+        }
+
       subArrayClear(s->panels, True);
     }
 
-  /* Clear arrays */
-  subArrayClear(subtle->hooks,     True); ///< Must be first
-  subArrayClear(subtle->grabs,     True);
-  subArrayClear(subtle->gravities, True);
-  subArrayClear(subtle->sublets,   False);
-  subArrayClear(subtle->tags,      True);
-  subArrayClear(subtle->views,     True);
+  /* Clear hooks and grabs except the ones of kept sublets */
+  for(i = 0; i < subtle->hooks->ndata; i++) ///< Must be first
+    {
+      SubHook *h = HOOK(subtle->hooks->data[i]);
+
+      if(!RubySubletKept(h->proc))
+        {
+          subArrayRemove(subtle->hooks, (void *)h);
+          subHookKill(h);
+          i--; ///< Prevent skipping of entries
+        }
+    }
+
+  for(i = 0; i < subtle->grabs->ndata; i++)
+    {
+      SubGrab *g = GRAB(subtle->grabs->data[i]);
+
+      if(!(g->flags & SUB_GRAB_PROC && RubySubletKept(g->data.num)))
+        {
+          subArrayRemoveUnordered(subtle->grabs, (void *)g); ///< Sorted on load
+          subGrabKill(g);
+          i--; ///< Prevent skipping of entries
+        }
+    }
+
+  /* Move gravities, tags and views aside, unchanged ones are kept on load */
+  reload.gravities  = subtle->gravities;
+  reload.tags       = subtle->tags;
+  reload.views      = subtle->views;
+  subtle->gravities = subArrayNew();
+  subtle->tags      = subArrayNew();
+  subtle->views     = subArrayNew();
+
+  subArrayReserve(subtle->gravities, reload.gravities->ndata);
+  subArrayReserve(subtle->tags,      reload.tags->ndata);
+  subArrayReserve(subtle->views,     reload.views->ndata);
+
+  /* Unregister old tag names to allow new tags of the same name */
+  for(i = 0; i < reload.tags->ndata; i++)
+    XDeleteContext(subtle->dpy,
+      (XID)XrmStringToQuark(TAG(reload.tags->data[i])->name), TAGID);
+
+  for(i = 0; i < subtle->sublets->ndata; i++)
+    {
+      SubPanel *p = PANEL(subtle->sublets->data[i]);
+
+      if(!(p->sublet->flags & SUB_SUBLET_KEEP))
+        {
+          subArrayRemove(subtle->sublets, (void *)p); ///< Killed with panels
+          i--; ///< Prevent skipping of entries
+        }
+    }
 
   /* Load and configure */
   subRubyLoadConfig();
+
+  /* Kill the ones that weren't kept */
+  subArrayKill(reload.views,     True);
+  subArrayKill(reload.tags,      True);
+  subArrayKill(reload.gravities, True);
+
+  reload.gravities = reload.tags = reload.views = NULL;
+
+  /* Free fonts that weren't reused */
+  rb_hash_foreach(reload.fonts, RubyForeachFont, Qnil);
+
+  rb_gc_unregister_address(&reload.entries);
+  rb_gc_unregister_address(&reload.fonts);
+  reload.entries = reload.fonts = Qnil;
+
+  /* Unload kept sublets when their config changed */
+  for(i = 0; i < subtle->sublets->ndata; i++)
+    {
+      SubPanel *p = PANEL(subtle->sublets->data[i]);
+      VALUE name = CHAR2SYM(p->sublet->name);
+
+      p->sublet->flags &= ~SUB_SUBLET_KEEP;
+
+      if(!rb_equal(rb_hash_lookup(sublets, name),
+          rb_hash_lookup(config_sublets, name)))
+        {
+          subRubyUnloadSublet(p);
+          i--; ///< Prevent skipping of entries
+        }
+      else
+        {
+          int state = 0;
+          VALUE rargs[2] = { name, (VALUE)p->sublet };
+
+          /* Update style ids */
+          rb_protect(RubyWrapSubletConfig, (VALUE)&rargs, &state);
+          if(state) RubyBacktrace();
+        }
+    }
+
   subRubyLoadSublets();
   subRubyLoadPanels();
   subDisplayConfigure();
@@ -3704,12 +4473,25 @@ subRubyReloadConfig(void)
         SCREEN(subtle->screens->data[i])->viewid = vids[i];
     }
 
-  /* Update client tags */
+  /* Update client tags when tags, views or gravities changed or
+   * clients still refer to ones created at runtime */
+  changed = !rb_equal(digest, config_digest);
+
   for(i = 0; i < subtle->clients->ndata; i++)
     {
       int flags = 0;
 
-      c            = CLIENT(subtle->clients->data[i]);
+      c = CLIENT(subtle->clients->data[i]);
+
+      if(!changed && !RubyClientStale(c)) continue;
+
+      /* Drop view gravities that are gone */
+      for(j = 0; c->gravities && j < subtle->views->ndata; j++)
+        {
+          if(c->gravities[j] >= subtle->gravities->ndata)
+            c->gravities[j] = MAX(0, subtle->gravity);
+        }
+
       c->gravityid = -1;
       c->flags     = (c->flags & (SUB_TYPE_CLIENT|SUB_CLIENT_FOCUS|
         SUB_CLIENT_INPUT|SUB_CLIENT_CLOSE)); ///< Reset flags
@@ -3719,6 +4501,17 @@ subRubyReloadConfig(void)
       subClientToggle(c, ~c->flags & flags, True); ///< Toggle flags
     }
 
+  /* Update key grabs when they changed */
+  if(!rb_equal(grabs, RubyGrabList()))
+    {
+      subGrabUnset(ROOT);
+      subGrabSet(ROOT, SUB_GRAB_KEY);
+    }
+
+  RB_GC_GUARD(sublets);
+  RB_GC_GUARD(digest);
+  RB_GC_GUARD(grabs);
+
   printf("Reloaded config\n");
 
   /* Update screens and panels */
@@ -3727,10 +4520,11 @@ subRubyReloadConfig(void)
   subScreenRender();
   subPanelPublish();
 
-  /* Focus pointer window */
+  /* Focus pointer window or the client below it */
   XQueryPointer(subtle->dpy, ROOT, &root, &win, &rx, &ry, &x, &y, &mask);
 
-  if((c = CLIENT(subSubtleFind(win, CLIENTID))))
+  if((c = CLIENT(subSubtleFind(win, CLIENTID))) ||
+      (c = subIndexFind(rx, ry)))
     subClientFocus(c, True);
   else
     {
@@ -3753,6 +4547,7 @@ void
 subRubyLoadSublet(const char *file)
 {
   int state = 0;
+  struct stat st;
   SubPanel *p = NULL;
   VALUE rargs[3] = { Qnil };
 
@@ -3761,6 +4556,14 @@ subRubyLoadSublet(const char *file)
   p->sublet->instance = Data_Wrap_Struct(rb_const_get(mod,
     rb_intern("Sublet")), NULL, NULL, (void *)p);
 
+  /* Remember source to detect changes on reload */
+  p->sublet->path = strdup(file);
+  if(0 == stat(file, &st))
+    {
+      p->sublet->mtime = st.st_mtime;
+      p->sublet->size  = st.st_size;
+    }
+
   rb_ary_push(shelter, p->sublet->instance); ///< Protect from GC
 
   if(Qfalse == RubyConfigLoadConfig(p->sublet->instance, rb_str_new2(file)))
@@ -3825,7 +4628,11 @@ subRubyUnloadSublet(SubPanel *p)
     {
       SubScreen *s = SCREEN(subtle->screens->data[i]);
 
-      if(s->panels) subArrayRemove(s->panels, (void *)p);
+      if(s->panels && 0 <= subArrayIndex(s->panels, (void *)p))
+        {
+          subArrayRemove(s->panels, (void *)p);
+          s->flags |= SUB_SCREEN_REFLOW; ///< Close gap of removed panel
+        }
     }
 
   /* Remove hooks */
@@ -3850,18 +4657,89 @@ subRubyUnloadSublet(SubPanel *p)
       if(grab->flags & SUB_GRAB_PROC &&
           RubyReceiver(p->sublet->instance, grab->data.num))
         {
-          subArrayRemove(subtle->grabs, (void *)grab);
+          subArrayRemoveUnordered(subtle->grabs, (void *)grab);
           subRubyRelease(grab->data.num);
           subGrabKill(grab);
           i--; ///< Prevent skipping of entries
         }
     }
 
+  subArraySort(subtle->grabs, subGrabCompare);
+
   subArrayRemove(subtle->sublets, (void *)p);
   subPanelKill(p);
   subPanelPublish();
 } /* }}} */
 
+ /** subRubyReloadSublet {{{
+  * @brief Reload a single sublet and update panels
+  * @param[in]  name  File name of sublet
+  **/
+
+void
+subRubyReloadSublet(const char *name)
+{
+  int i, j, len = 0;
+  char buf[PATH_MAX] = { 0 };
+  SubPanel *p = NULL;
+
+  assert(name);
+
+  if(fnmatch("*.rb", name, FNM_PATHNAME)) return;
+
+  /* Append file name to path */
+  if(0 > (len = RubySubletsPath(buf, sizeof(buf))) ||
+      sizeof(buf) - len <= (size_t)snprintf(buf + len,
+        sizeof(buf) - len, "/%s", name))
+    return;
+
+  /* Unload old and load new version if any */
+  if((p = RubySubletFind(buf))) subRubyUnloadSublet(p);
+  if(-1 != access(buf, R_OK)) subRubyLoadSublet(buf);
+
+  /* Reset sublet panel flags */
+  for(i = 0; i < subtle->sublets->ndata; i++)
+    {
+      p = PANEL(subtle->sublets->data[i]);
+
+      p->flags &= ~(SUB_PANEL_BOTTOM|SUB_PANEL_SPACER1|
+        SUB_PANEL_SPACER1| SUB_PANEL_SEPARATOR1|SUB_PANEL_SEPARATOR2|
+        SUB_PANEL_PLACED);
+      p->screen = NULL;
+    }
+
+  /* Reset screen panels but keep sublets */
+  for(i = 0; i < subtle->screens->ndata; i++)
+    {
+      SubScreen *s = SCREEN(subtle->screens->data[i]);
+
+      for(j = 0; j < s->panels->ndata; j++)
+        {
+          p = PANEL(s->panels->data[j]);
+
+          if(p->flags & SUB_PANEL_SUBLET && !(p->flags & SUB_PANEL_COPY))
+            {
+              subArrayRemove(s->panels, (void *)p);
+              j--; ///< Prevent skipping of entries
+            }
+        }
+
+      s->flags |= SUB_SCREEN_REFLOW; ///< Force layout
+      subArrayClear(s->panels, True);
+    }
+
+  /* Update grabs of sublet */
+  subArraySort(subtle->grabs, subGrabCompare);
+  subGrabUnset(ROOT);
+  subGrabSet(ROOT, SUB_GRAB_KEY);
+
+  /* Place sublets again */
+  subRubyLoadPanels();
+  subScreenUpdate();
+  subScreenRender();
+  subPanelPublish();
+} /* }}} */
+
  /** subRubyLoadPanels {{{
   * @brief Load panels
   **/
@@ -3891,7 +4769,7 @@ void
 subRubyLoadSublets(void)
 {
   int i, num, len = 0;
-  char buf[100] = { 0 };
+  char buf[PATH_MAX] = { 0 };
   struct dirent **entries = NULL;
 
 #ifdef HAVE_SYS_INOTIFY_H
@@ -3909,34 +4787,30 @@ subRubyLoadSublets(void)
     }
 #endif /* HAVE_SYS_INOTIFY_H */
 
-  /* Check path */
-  if(subtle->paths.sublets)
-    len += snprintf(buf, sizeof(buf), "%s", subtle->paths.sublets);
-  else
-    {
-      char *home = NULL;
+  if(0 > (len = RubySubletsPath(buf, sizeof(buf)))) return;
 
-      if((home = getenv("XDG_DATA_HOME")))
-        {
-          len += snprintf(buf, sizeof(buf), "%s/%s/sublets",
-            home, PKG_NAME);
-        }
-      else len += snprintf(buf, sizeof(buf), "%s/.local/share/%s/sublets",
-        getenv("HOME"), PKG_NAME);
-    }
+#ifdef HAVE_SYS_INOTIFY_H
+  /* Watch directory for changed sublets */
+  if(0 < (subtle->watch = inotify_add_watch(subtle->notify, buf,
+      IN_CLOSE_WRITE|IN_MOVED_TO|IN_MOVED_FROM|IN_DELETE)))
+    subSubtleLogDebug("Inotify: add watch=%s\n", buf);
+  else subtle->watch = 0;
+#endif /* HAVE_SYS_INOTIFY_H */
 
   /* Scan directory */
   if(0 < ((num = scandir(buf, &entries, RubyFilter, alphasort))))
     {
       for(i = 0; i < num; i++)
         {
-          /* Temporary append file name to path */
-          snprintf(buf + len, sizeof(buf), "/%s", entries[i]->d_name);
-
-          subRubyLoadSublet(buf);
+          /* Temporary append file name to path and skip sublets
+           * kept on reload */
+          if(sizeof(buf) - len > (size_t)snprintf(buf + len,
+              sizeof(buf) - len, "/%s", entries[i]->d_name) &&
+              !RubySubletFind(buf))
+            subRubyLoadSublet(buf);
 
           /* Restore path */
-          buf[strlen(buf) - (strlen(entries[i]->d_name) + 1)] = '\0';
+          buf[len] = '\0';
 
           free(entries[i]);
         }
@@ -3968,10 +4842,19 @@ subRubyCall(int type,
   rargs[1] = proc;
   rargs[2] = (VALUE)data;
 
+  /* Hold back GC while dispatching, collected when idle */
+  if(0 == collector.depth++) collector.disabled = rb_gc_disable();
+
   /* Carefully call */
   rb_protect(RubyWrapCall, (VALUE)&rargs, &state);
   if(state) RubyBacktrace();
 
+  if(0 == --collector.depth && Qfalse == collector.disabled) rb_gc_enable();
+  collector.calls++;
+
+  /* Handle messages subtlext sent from this call */
+  if(0 == collector.depth) subEventDirectFlush(False);
+
 #ifdef DEBUG
   subSubtleLogDebugRuby("Call: GC START\n");
   rb_gc_start();
@@ -3980,6 +4863,68 @@ subRubyCall(int type,
   return !state; ///< Reverse odd logic
 } /* }}} */
 
+ /** subRubyCollect {{{
+  * @brief Run GC steps while idle and publish stats
+  * @param[in]  wait  Time until next deadline in milliseconds
+  **/
+
+void
+subRubyCollect(int wait)
+{
+  long data[6] = { 0 };
+  struct timeval start, end;
+
+  /* Skip when nothing ran since last time or wait is too short */
+  if(0 == collector.calls || 0 < collector.depth || GCIDLE > wait) return;
+
+  gettimeofday(&start, NULL);
+
+  /* Minor steps by default, full run after GCMAJOR steps when there is
+   * enough time left until the next deadline */
+  collector.idle++;
+
+  if(GCMAJOR <= ++collector.steps && GCMAJORIDLE <= wait)
+    {
+      rb_gc_start();
+      collector.major++;
+      collector.steps = 0;
+    }
+  else
+    {
+#ifdef HAVE_RB_FUNCALLV_KW
+      VALUE opts = rb_hash_new();
+
+      rb_hash_aset(opts, CHAR2SYM("full_mark"), Qfalse);
+      rb_funcallv_kw(rb_mGC, rb_intern("start"), 1, &opts, RB_PASS_KEYWORDS);
+#else /* HAVE_RB_FUNCALLV_KW */
+      rb_gc_start();
+#endif /* HAVE_RB_FUNCALLV_KW */
+    }
+
+  gettimeofday(&end, NULL);
+
+  /* Update stats in microseconds */
+  collector.calls  = 0;
+  collector.last   = (end.tv_sec - start.tv_sec) * 1000000L +
+    (end.tv_usec - start.tv_usec);
+  collector.total += collector.last;
+  if(collector.last > collector.max) collector.max = collector.last;
+
+  data[0] = collector.idle;
+  data[1] = collector.major;
+  data[2] = collector.last;
+  data[3] = collector.max;
+  data[4] = collector.total;
+#ifdef HAVE_RB_GC_COUNT
+  data[5] = rb_gc_count();
+#endif /* HAVE_RB_GC_COUNT */
+
+  subEwmhSetCardinals(ROOT, SUB_EWMH_SUBTLE_GC, data, LENGTH(data));
+
+  subSubtleLogDebugRuby("Collect: wait=%d, last=%ld, major=%ld\n",
+    wait, collector.last, collector.major);
+} /* }}} */
+
  /** subRubyRelease {{{
   * @brief Release value from shelter
   * @param[in]  value  The released value
@@ -3995,6 +4940,28 @@ subRubyRelease(unsigned long value)
   return state;
 } /* }}} */
 
+ /** subRubyProxyKill {{{
+  * @brief Drop hook proxy of client
+  * @param[in]  win  Client window
+  **/
+
+void
+subRubyProxyKill(unsigned long win)
+{
+  if(!NIL_P(proxies)) rb_hash_delete(proxies, LONG2NUM(win));
+} /* }}} */
+
+ /** subRubyIconFlush {{{
+  * @brief Drop colorized copies of an icon freed by subtlext
+  * @param[in]  pixmap  Freed pixmap
+  **/
+
+void
+subRubyIconFlush(Pixmap pixmap)
+{
+  if(None != pixmap) subSharedDrawIconFlush(subtle->dpy, pixmap);
+} /* }}} */
+
  /** subRubyFinish {{{
   * @brief Finish ruby stack
   **/
@@ -88,6 +88,52 @@ ScreenClear(SubScreen *s,
     }
 } /* }}} */
 
+/* ScreenRender {{{ */
+static void
+ScreenRender(SubScreen *s,
+  Window panel,
+  unsigned long col,
+  int bottom)
+{
+  int i, pass;
+
+  /* Skip disabled panels */
+  if(!(s->flags & (bottom ? SUB_SCREEN_PANEL2 : SUB_SCREEN_PANEL1))) return;
+
+  ScreenClear(s, col);
+
+  /* Queue all backgrounds and borders first, submit them in one request
+   * per color and draw text and icons on top afterwards */
+  for(pass = True; pass >= False; pass--)
+    {
+      for(i = 0; s->panels && i < s->panels->ndata; i++)
+        {
+          SubPanel *p = PANEL(s->panels->data[i]);
+
+          if(p->flags & SUB_PANEL_HIDDEN) continue;
+          if(bottom != !!(p->flags & SUB_PANEL_BOTTOM)) continue;
+
+          subPanelRender(p, s->drawable, pass);
+        }
+
+      if(pass) subPanelFlush(s->drawable);
+    }
+
+  XCopyArea(subtle->dpy, s->drawable, panel, subtle->gcs.draw,
+    0, 0, s->base.width, subtle->ph, 0, 0);
+} /* }}} */
+
+/* ScreenDeltaPush {{{ */
+static void
+ScreenDeltaPush(SubArray **a,
+  void *data)
+{
+  /* Create lazily to keep quiet tiles cheap */
+  if(!*a) *a = subArrayNew();
+
+  subArrayPush(*a, data);
+} /* }}} */
+
 /* Public */
 
  /** subScreenInit {{{
@@ -302,11 +348,21 @@ subScreenConfigure(void)
   SubView *v = NULL;
 
   /* Reset visible tags, views and available clients */
-  subtle->visible_tags  = 0;
-  subtle->visible_views = 0;
-  subtle->client_tags   = 0;
+  subSharedTagsClear(&subtle->visible_tags);
+  subSharedTagsClear(&subtle->visible_views);
+  subSharedTagsClear(&subtle->client_tags);
+
+  /* Set visible tags and views to ease lookups */
+  for(i = 0; i < subtle->screens->ndata; i++)
+    {
+      s = SCREEN(subtle->screens->data[i]);
+      v = VIEW(subtle->views->data[s->viewid]);
+
+      subSharedTagsOr(&subtle->visible_tags, &v->tags);
+      subSharedTagsSet(&subtle->visible_views, s->viewid);
+    }
 
-  /* Either check each client or just get visible clients */
+  /* Check each client */
   if(0 < subtle->clients->ndata)
     {
       int j;
@@ -321,7 +377,7 @@ subScreenConfigure(void)
           if(c->flags & SUB_CLIENT_DEAD) continue;
 
           /* Set available client tags to ease lookups */
-          subtle->client_tags |= c->tags;
+          subSharedTagsOr(&subtle->client_tags, &c->tags);
 
           /* Check view of each screen */
           for(j = 0; j < subtle->screens->ndata; j++)
@@ -329,10 +385,6 @@ subScreenConfigure(void)
               s = SCREEN(subtle->screens->data[j]);
               v = VIEW(subtle->views->data[s->viewid]);
 
-              /* Set visible tags and views to ease lookups */
-              subtle->visible_tags  |= v->tags;
-              subtle->visible_views |= (1L << (s->viewid + 1));
-
               /* Find visible clients */
               if(VISIBLETAGS(c, v->tags))
                 {
@@ -356,8 +408,21 @@ subScreenConfigure(void)
           /* After all screens are checked.. */
           if(0 < visible)
             {
-              /* Update client */
-              subClientArrange(c, gravityid, screenid);
+              /* Update client or leave it to the layout of the view */
+              if(VIEW(subtle->views->data[viewid])->flags & SUB_VIEW_LAYOUT &&
+                  !(c->flags & LAYOUTMASK))
+                {
+                  c->screenid = screenid;
+
+                  if(c->gravityid != gravityid)
+                    {
+                      c->gravityid = gravityid;
+
+                      subEwmhSetCardinals(c->win,
+                        SUB_EWMH_SUBTLE_CLIENT_GRAVITY, (long *)&c->gravityid, 1);
+                    }
+                }
+              else subClientArrange(c, gravityid, screenid);
               XMapWindow(subtle->dpy, c->win);
               subEwmhSetWMState(c->win, NormalState);
 
@@ -381,34 +446,84 @@ subScreenConfigure(void)
             }
         }
     }
-  else
-    {
-      /* Check views of each screen */
-      for(i = 0; i < subtle->screens->ndata; i++)
-        {
-          s = SCREEN(subtle->screens->data[i]);
-          v = VIEW(subtle->views->data[s->viewid]);
 
-          /* Set visible tags and views to ease lookups */
-          subtle->visible_tags  |= v->tags;
-          subtle->visible_views |= (1L << (s->viewid + 1));
-        }
-    }
+  subIndexDirty(-1); ///< Visibility may have changed
+
+  /* Apply view layouts in one pass per screen */
+  for(i = 0; i < subtle->screens->ndata; i++)
+    subClientLayout(i);
 
   /* EWMH: Visible tags, views */
-  subEwmhSetCardinals(ROOT, SUB_EWMH_SUBTLE_VISIBLE_TAGS,
-    (long *)&subtle->visible_tags, 1);
-  subEwmhSetCardinals(ROOT, SUB_EWMH_SUBTLE_VISIBLE_VIEWS,
-    (long *)&subtle->visible_views, 1);
+  subEwmhSetTags(ROOT, SUB_EWMH_SUBTLE_VISIBLE_TAGS, &subtle->visible_tags);
+  subEwmhSetTags(ROOT, SUB_EWMH_SUBTLE_VISIBLE_VIEWS, &subtle->visible_views);
 
   XSync(subtle->dpy, False); ///< Sync before going on
 
   /* Hook: Configure */
-  subHookCall(SUB_HOOK_TILE, NULL);
+  subScreenTile();
 
   subSubtleLogDebugSubtle("Configure\n");
 } /* }}} */
 
+ /** subScreenTile {{{
+  * @brief Call tile hook with clients that were added, removed, moved
+  *        or changed visibility since the last call
+  **/
+
+void
+subScreenTile(void)
+{
+  int i;
+  SubDelta delta = { NULL };
+
+  /* Skip delta when nobody listens, untracked clients stay new */
+  if(!subHookCheck(SUB_HOOK_TILE))
+    {
+      subArrayClear(subtle->removed, False);
+
+      return;
+    }
+
+  /* Compare clients with state at last tile */
+  for(i = 0; i < subtle->clients->ndata; i++)
+    {
+      SubClient *c = CLIENT(subtle->clients->data[i]);
+      int screenid = -1, gravityid = -1;
+
+      if(c->flags & SUB_CLIENT_DEAD) continue;
+
+      if(VISIBLE(c))
+        {
+          screenid  = c->screenid;
+          gravityid = c->gravityid;
+        }
+
+      if(-2 == c->tilescreenid)
+        ScreenDeltaPush(&delta.added, (void *)c);
+      else if(-1 == c->tilescreenid && -1 != screenid)
+        ScreenDeltaPush(&delta.shown, (void *)c);
+      else if(-1 != c->tilescreenid && -1 == screenid)
+        ScreenDeltaPush(&delta.hidden, (void *)c);
+      else if(c->tilescreenid != screenid || c->tilegravityid != gravityid)
+        ScreenDeltaPush(&delta.moved, (void *)c);
+
+      c->tilescreenid  = screenid;
+      c->tilegravityid = gravityid;
+    }
+
+  if(0 < subtle->removed->ndata) delta.removed = subtle->removed;
+
+  /* Hook: Tile */
+  subHookCall(SUB_HOOK_TILE, (void *)&delta);
+
+  if(delta.added)  subArrayKill(delta.added,  False);
+  if(delta.moved)  subArrayKill(delta.moved,  False);
+  if(delta.shown)  subArrayKill(delta.shown,  False);
+  if(delta.hidden) subArrayKill(delta.hidden, False);
+
+  subArrayClear(subtle->removed, False);
+} /* }}} */
+
  /** subScreenUpdate {{{
   * @brief Update screens
   **/
@@ -427,15 +542,35 @@ subScreenUpdate(void)
       int x[4] = { 0 }, nspacer[4] = { 0 }; ///< Waste ints but it's easier for the algo
       int sw[4] = { 0 }, fix[4] = { 0 }, width[4] = { 0 }, spacer[4] = { 0 };
 
-      /* Pass 1: Collect width for spacer sizes */
+      /* Pass 0: Update content and check if any item changed its width
+       * or visibility since the last layout */
       for(j = 0; s->panels && j < s->panels->ndata; j++)
         {
           p = PANEL(s->panels->data[j]);
 
-          subPanelUpdate(p);
+          if(subPanelUpdate(p) || !(p->flags & SUB_PANEL_HIDDEN) !=
+              !!(p->flags & SUB_PANEL_PLACED))
+            s->flags |= SUB_SCREEN_REFLOW;
+        }
+
+      /* Skip layout when nothing moved */
+      if(!(s->flags & SUB_SCREEN_REFLOW)) continue;
+
+      /* Pass 1: Collect width for spacer sizes */
+      for(j = 0; s->panels && j < s->panels->ndata; j++)
+        {
+          p = PANEL(s->panels->data[j]);
 
           /* Check flags */
-          if(p->flags & SUB_PANEL_HIDDEN)  continue;
+          if(p->flags & SUB_PANEL_HIDDEN)
+            {
+              p->flags &= ~SUB_PANEL_PLACED;
+
+              continue;
+            }
+
+          p->flags |= SUB_PANEL_PLACED;
+
           if(0 == npanel && p->flags & SUB_PANEL_BOTTOM)
             {
               npanel = 1;
@@ -532,6 +667,8 @@ subScreenUpdate(void)
 
           x[offset] += p->width;
         }
+
+      s->flags &= ~SUB_SCREEN_REFLOW;
     }
 
   subSubtleLogDebugSubtle("Update\n");
@@ -544,41 +681,48 @@ subScreenUpdate(void)
 void
 subScreenRender(void)
 {
-  int i, j;
+  int i;
+
+  /* Merge scheduled updates into this frame */
+  if(subtle->flags & SUB_SUBTLE_RENDER)
+    {
+      subtle->flags &= ~SUB_SUBTLE_RENDER;
+
+      subScreenUpdate();
+    }
 
   /* Render all screens */
   for(i = 0; i < subtle->screens->ndata; i++)
     {
       SubScreen *s = SCREEN(subtle->screens->data[i]);
-      Window panel = s->panel1;
 
-      ScreenClear(s, subtle->styles.subtle.top);
+      ScreenRender(s, s->panel1, subtle->styles.subtle.top, False);
+      ScreenRender(s, s->panel2, subtle->styles.subtle.bottom, True);
+    }
 
-      /* Render panel items */
-      for(j = 0; s->panels && j < s->panels->ndata; j++)
-        {
-          SubPanel *p = PANEL(s->panels->data[j]);
+  XSync(subtle->dpy, False); ///< Sync before going on
 
-          if(p->flags & SUB_PANEL_HIDDEN) continue;
-          if(panel != s->panel2 && p->flags & SUB_PANEL_BOTTOM)
-            {
-              XCopyArea(subtle->dpy, s->drawable, panel, subtle->gcs.draw,
-                0, 0, s->base.width, subtle->ph, 0, 0);
+  /* Set deadline of next frame */
+  if(0 < subtle->fps) subtle->frame = subSubtleTicks() + 1000 / subtle->fps;
 
-              ScreenClear(s, subtle->styles.subtle.bottom);
-              panel = s->panel2;
-            }
+  subSubtleLogDebugSubtle("Render\n");
+} /* }}} */
 
-          subPanelRender(p, s->drawable);
-        }
+ /** subScreenSchedule {{{
+  * @brief Update and render screens or defer both to the next frame
+  *   when a maximum panel refresh rate is set
+  **/
 
-      XCopyArea(subtle->dpy, s->drawable, panel, subtle->gcs.draw,
-        0, 0, s->base.width, subtle->ph, 0, 0);
+void
+subScreenSchedule(void)
+{
+  /* Render now when uncapped or frame is due */
+  if(0 >= subtle->fps || subSubtleTicks() >= subtle->frame)
+    {
+      subScreenUpdate();
+      subScreenRender();
     }
-
-  XSync(subtle->dpy, False); ///< Sync before going on
-
-  subSubtleLogDebugSubtle("Render\n");
+  else subtle->flags |= SUB_SUBTLE_RENDER; ///< Handled by event loop
 } /* }}} */
 
  /** subScreenResize {{{
@@ -597,6 +741,8 @@ subScreenResize(void)
     {
       SubScreen *s = SCREEN(subtle->screens->data[i]);
 
+      s->flags |= SUB_SCREEN_REFLOW; ///< Force layout
+
       /* Add strut */
       s->geom.x      = s->base.x + subtle->styles.subtle.padding.left;
       s->geom.y      = s->base.y + subtle->styles.subtle.padding.top;
@@ -668,6 +814,7 @@ subScreenKill(SubScreen *s)
   assert(s);
 
   if(s->panels) subArrayKill(s->panels, True);
+  if(s->index)  free(s->index);
 
   /* Destroy panel windows */
   if(s->panel1)
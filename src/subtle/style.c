@@ -197,6 +197,7 @@ subStyleReset(SubStyle *s,
   if(s->flags & SUB_STYLE_FONT && s->font)
     {
       subSharedFontKill(subtle->dpy, s->font);
+      subTextFlush();
       s->flags &= ~SUB_STYLE_FONT;
     }
 
@@ -262,7 +263,10 @@ subStyleKill(SubStyle *s)
 
   /* Free font */
   if(s->flags & SUB_STYLE_FONT && s->font)
-    subSharedFontKill(subtle->dpy, s->font);
+    {
+      subSharedFontKill(subtle->dpy, s->font);
+      subTextFlush();
+    }
 
   /* Free separator */
   if(s->flags & SUB_STYLE_SEPARATOR && s->separator)
@@ -163,6 +163,21 @@ subSubtleTime(void)
   return tv.tv_sec;
 } /* }}} */
 
+ /** subSubtleTicks {{{
+  * @brief Get the current time in milliseconds
+  * @return Returns time in milliseconds
+  **/
+
+unsigned long
+subSubtleTicks(void)
+{
+  struct timeval tv;
+
+  gettimeofday(&tv, 0);
+
+  return tv.tv_sec * 1000UL + tv.tv_usec / 1000;
+} /* }}} */
+
  /** subSubtleLog {{{
   * @brief Print messages depending on type
   * @param[in]  level   Message level
@@ -246,6 +261,7 @@ subSubtleFinish(void)
       if(subtle->trays)     subArrayKill(subtle->trays,     True);
       if(subtle->views)     subArrayKill(subtle->views,     True);
       if(subtle->hooks)     subArrayKill(subtle->hooks,     False);
+      if(subtle->removed)   subArrayKill(subtle->removed,   False);
 
       /* Reset styles to free fonts and substyles */
       subStyleReset(&subtle->styles.all,       0);
@@ -256,11 +272,20 @@ subSubtleFinish(void)
       subStyleReset(&subtle->styles.clients,   0);
       subStyleReset(&subtle->styles.subtle,    0);
 
+      if(subtle->dpy) subSharedDrawIconFlush(subtle->dpy, None);
+
+      subPanelFinish();
       subEventFinish();
       subRubyFinish();
       subEwmhFinish();
       subDisplayFinish();
 
+      /* Kill pools last, objects are returned until here */
+      if(subtle->pools.clients) subPoolKill(subtle->pools.clients);
+      if(subtle->pools.trays)   subPoolKill(subtle->pools.trays);
+      if(subtle->pools.panels)  subPoolKill(subtle->pools.panels);
+      if(subtle->pools.items)   subPoolKill(subtle->pools.items);
+
       free(subtle);
     }
 } /* }}} */
@@ -293,6 +318,12 @@ main(int argc,
   subtle->flags    |= (SUB_SUBTLE_XRANDR|SUB_SUBTLE_XINERAMA);
   subtle->loglevel  = DEFAULT_LOGLEVEL;
 
+  /* Pools for objects with a lot of churn */
+  subtle->pools.clients = subPoolNew("clients", sizeof(SubClient),   32);
+  subtle->pools.trays   = subPoolNew("trays",   sizeof(SubTray),     8);
+  subtle->pools.panels  = subPoolNew("panels",  sizeof(SubPanel),    16);
+  subtle->pools.items   = subPoolNew("items",   sizeof(SubTextItem), 64);
+
   /* Parse arguments */
   while(-1 != (c = getopt_long(argc, argv, "c:d:hknrs:vl:D",
       long_options, NULL)))
@@ -360,6 +391,7 @@ main(int argc,
   subtle->tags      = subArrayNew();
   subtle->trays     = subArrayNew();
   subtle->views     = subArrayNew();
+  subtle->removed   = subArrayNew();
 
   /* Init */
   SubtleVersion();
@@ -41,17 +41,23 @@
 
 /* Macros {{{ */
 #define FLAGS        unsigned int                                 ///< Flags
-#define TAGS         unsigned int                                 ///< Tags
+#define TAGS         SubTags                                      ///< Tags
 
 #define CLIENTID     1L                                           ///< Client data id
 #define TRAYID       2L                                           ///< Tray data id
 #define SCREENID     3L                                           ///< Screen data id
+#define TAGID        4L                                           ///< Tag name id
+#define GRAVITYID    5L                                           ///< Gravity name id
 
 #define MINW         1L                                           ///< Client min width
 #define MINH         1L                                           ///< Client min height
 #define WAITTIME     10                                           ///< Max waiting time
-#define HISTORYSIZE  5                                            ///< Size of the focus history
-#define DEFAULTTAG   (1L << 1)                                    ///< Default tag
+#define HISTORYSIZE  5                                            ///< Focus history entries preferred on select
+#define GCIDLE       50                                           ///< Min idle time for GC steps
+#define GCMAJOR      16                                           ///< Idle GC steps per full run
+#define GCMAJORIDLE  1000                                         ///< Min time to next deadline for a full run
+#define RETAGDELAY   500                                          ///< Delay of live retag in ms
+#define DEFAULTTAG   0                                            ///< Default tag id
 
 #define GRAVITYSTRLIMIT 1                                         ///< Gravity string limit to ignore \0
 
@@ -98,7 +104,7 @@
 #define VISIBLE(C) VISIBLETAGS(C,subtle->visible_tags)            ///< Whether client is visible
 
 #define VISIBLETAGS(C,Tags) \
-  (C && (Tags & c->tags || \
+  (C && (subSharedTagsAny(&(Tags), &C->tags) || \
   C->flags & (SUB_CLIENT_TYPE_DESKTOP|SUB_CLIENT_MODE_STICK)))    ///< Whether client is visible on tags
 
 #define ROOT DefaultRootWindow(subtle->dpy)                       ///< Root window
@@ -146,12 +152,16 @@
   EnterWindowMask|FocusChangeMask)
 #define GRABMASK \
   (ButtonPressMask|ButtonReleaseMask|PointerMotionMask)
+#define LAYOUTMASK \
+  (SUB_CLIENT_MODE_FLOAT|SUB_CLIENT_MODE_FULL|\
+  SUB_CLIENT_TYPE_DESKTOP|SUB_CLIENT_TYPE_DOCK)
 /* }}} */
 
 /* Casts {{{ */
 #define ARRAY(a)     ((SubArray *)a)                              ///< Cast to SubArray
 #define CHAIN(c)     ((SubChain *)c)                              ///< Cast to SubChain
 #define CLIENT(c)    ((SubClient *)c)                             ///< Cast to SubClient
+#define DELTA(d)     ((SubDelta *)d)                              ///< Cast to SubDelta
 #define GRAB(g)      ((SubGrab *)g)                               ///< Cast to SubGrab
 #define GRAVITY(g)   ((SubGravity *)g)                            ///< Cast to SubGravity
 #define HOOK(h)      ((SubHook *)h)                               ///< Cast to SubHook
@@ -200,6 +210,7 @@
 #define SUB_CALL_OVER                 (1L << 16)                  ///< Call mouse over hook
 #define SUB_CALL_OUT                  (1L << 17)                  ///< Call mouse out hook
 #define SUB_CALL_UNLOAD               (1L << 18)                  ///< Call unload hook
+#define SUB_CALL_TILE                 (1L << 19)                  ///< Call tile hook
 
 /* Hook flags */
 #define SUB_HOOK_START                (1L << 10)                  ///< Start hook
@@ -305,6 +316,8 @@
 #define SUB_PANEL_OVER                (1L << 26)                  ///< Panel mouse over
 #define SUB_PANEL_OUT                 (1L << 27)                  ///< Panel mouse out
 
+#define SUB_PANEL_PLACED              (1L << 28)                  ///< Panel placed by last layout
+
 /* Sublet flags */
 #define SUB_SUBLET_INTERVAL           (1L << 10)                  ///< Sublet has interval
 #define SUB_SUBLET_INOTIFY            (1L << 11)                  ///< Sublet with inotify
@@ -314,11 +327,14 @@
 #define SUB_SUBLET_DATA               (1L << 14)                  ///< Sublet data function
 #define SUB_SUBLET_WATCH              (1L << 15)                  ///< Sublet watch function
 #define SUB_SUBLET_UNLOAD             (1L << 16)                  ///< Sublet unload function
+#define SUB_SUBLET_KEEP               (1L << 17)                  ///< Sublet kept on reload
 
 /* Screen flags */
 #define SUB_SCREEN_PANEL1             (1L << 10)                  ///< Screen sanel1 enabled
 #define SUB_SCREEN_PANEL2             (1L << 11)                  ///< Screen sanel2 enabled
 #define SUB_SCREEN_STIPPLE            (1L << 12)                  ///< Screen stipple enabled
+#define SUB_SCREEN_REFLOW             (1L << 13)                  ///< Screen panel needs layout
+#define SUB_SCREEN_INDEX              (1L << 14)                  ///< Screen index is up to date
 
 /* Style flags */
 #define SUB_STYLE_FONT                (1L << 10)                  ///< Style has custom font
@@ -341,12 +357,17 @@
 #define SUB_SUBTLE_FOCUS_CLICK        (1L << 13)                  ///< Click to focus
 #define SUB_SUBTLE_SKIP_WARP          (1L << 14)                  ///< Skip pointer warp
 #define SUB_SUBTLE_SKIP_URGENT_WARP   (1L << 15)                  ///< Skip urgent warp
+#define SUB_SUBTLE_RENDER             (1L << 16)                  ///< Panel render pending
+#define SUB_SUBTLE_RETAG              (1L << 17)                  ///< Live retag pending
+#define SUB_SUBTLE_CLIENT_SNAP        (1L << 18)                  ///< Snap to neighbor clients
+#define SUB_SUBTLE_HISTORY            (1L << 19)                  ///< Focus history publish pending
 
 /* Tag flags */
 #define SUB_TAG_GRAVITY               (1L << 10)                  ///< Gravity property
 #define SUB_TAG_GEOMETRY              (1L << 11)                  ///< Geometry property
 #define SUB_TAG_POSITION              (1L << 12)                  ///< Position property
 #define SUB_TAG_PROC                  (1L << 13)                  ///< Tagging proc (must be <16)
+#define SUB_TAG_RETAG                 (1L << 14)                  ///< Live retag on name change (must be <16)
 
 /* Tag matcher */
 #define SUB_TAG_MATCH_NAME            (1L << 10)                  ///< Match WM_NAME
@@ -370,6 +391,7 @@
 #define SUB_VIEW_ICON                 (1L << 10)                  ///< View icon
 #define SUB_VIEW_ICON_ONLY            (1L << 11)                  ///< Icon only
 #define SUB_VIEW_DYNAMIC              (1L << 12)                  ///< Dynamic views
+#define SUB_VIEW_LAYOUT               (1L << 13)                  ///< View layout
 
 /* Special flags */
 #define SUB_RUBY_DATA                 (1L << 30)                  ///< Object stores ruby data
@@ -432,7 +454,7 @@
 /* Typedefs {{{ */
 typedef struct subarray_t /* {{{ */
 {
-  int   ndata;                                                    ///< Array data count
+  int   ndata, size;                                              ///< Array data count and capacity
   void **data;                                                    ///< Array data
 } SubArray; /* }}} */
 
@@ -444,21 +466,37 @@ typedef struct subkeychain_t /* {{{ */
 
 typedef struct subclient_t /* {{{ */
 {
+  /* Hot: Checked in scans over all clients, keep close together */
   FLAGS      flags;                                               ///< Client flags
-  char       *name, *instance, *klass, *role;                     ///< Client instance, klass
-
   TAGS       tags;                                                ///< Client tags
-  Window     win, leader;                                         ///< Client window and leader
-  Colormap   cmap;                                                ///< Client colormap
+  int        screenid, gravityid;                                 ///< Client current screen id, current gravity id
   XRectangle geom;                                                ///< Client geom
+  Window     win;                                                 ///< Client window
+  int        dir;                                                 ///< Client restacking dir
+
+  struct subclient_t *prev, *next;                                ///< Client focus history links
+  struct subclient_t *sprev, *snext;                              ///< Client screen focus history links
+
+  /* Cold: Only needed for single clients */
+  char       *name, *instance, *klass, *role;                     ///< Client name, interned instance, klass, role
+
+  Window     leader;                                              ///< Client leader
+  Colormap   cmap;                                                ///< Client colormap
 
   float      minr, maxr;                                          ///< Client ratios
   int        minw, minh, maxw, maxh, incw, inch, basew, baseh;    ///< Client sizes
 
-  int        dir, screenid, gravityid;                            ///< Client restacking dir, current screen id, current gravity id
   int        *gravities;                                          ///< Client gravities for views
+  int        retag;                                               ///< Client live retag pending
+  int        tilescreenid, tilegravityid;                         ///< Client screen and gravity at last tile hook
 } SubClient; /* }}} */
 
+typedef struct subdelta_t /* {{{ */
+{
+  struct subarray_t *added, *moved, *shown, *hidden;              ///< Delta changed clients
+  struct subarray_t *removed;                                     ///< Delta removed windows
+} SubDelta; /* }}} */
+
 typedef enum subewmh_t /* {{{ */
 {
   /* ICCCM */
@@ -565,6 +603,10 @@ typedef enum subewmh_t /* {{{ */
   SUB_EWMH_SUBTLE_FONT,                                           ///< Subtle font
   SUB_EWMH_SUBTLE_DATA,                                           ///< Subtle data
   SUB_EWMH_SUBTLE_VERSION,                                        ///< Subtle version
+  SUB_EWMH_SUBTLE_GC,                                             ///< Subtle GC stats
+  SUB_EWMH_SUBTLE_NAME_INDEX,                                     ///< Subtle hashed names
+  SUB_EWMH_SUBTLE_FOCUS_HISTORY,                                  ///< Subtle focus history
+  SUB_EWMH_SUBTLE_POOLS,                                          ///< Subtle pool stats
 
   SUB_EWMH_TOTAL
 } SubEwmh; /* }}} */
@@ -589,8 +631,9 @@ typedef struct subgravity_t /* {{{ */
 
 typedef struct subhook_t /* {{{ */
 {
-  FLAGS         flags;                                            ///< Hook flags
-  unsigned long proc;                                             ///< Hook proc
+  FLAGS           flags;                                          ///< Hook flags
+  unsigned long   proc;                                           ///< Hook proc
+  struct subtag_t *filter;                                        ///< Hook client filter
 } SubHook; /* }}} */
 
 typedef struct subicon_t /* {{{ */
@@ -599,10 +642,18 @@ typedef struct subicon_t /* {{{ */
   Pixmap  pixmap;                                                 ///< Icon pixmap
 } SubIcon; /* }}} */
 
+typedef struct subindex_t /* {{{ */
+{
+  struct subclient_t *client;                                     ///< Index client
+  XRectangle         geom;                                        ///< Index client geom
+  int                cx, stack;                                   ///< Index client center x, stacking position
+} SubIndex; /* }}} */
+
 typedef struct subpanel_t /* {{{ */
 {
   FLAGS                   flags;                                  ///< Panel flags
   int                     x, width;                               ///< Panel x, width
+  unsigned long           digest;                                 ///< Panel content at last measure
   struct subscreen_t      *screen;                                ///< Panel screen
 
   union {
@@ -612,6 +663,16 @@ typedef struct subpanel_t /* {{{ */
   };
 } SubPanel; /* }}} */
 
+typedef struct subpool_t /* {{{ */
+{
+  const char        *name;                                        ///< Pool name
+  size_t            size;                                         ///< Pool object size
+  int               perslab;                                      ///< Pool objects per slab
+  void              *slabs, *free;                                ///< Pool slabs, free list
+
+  unsigned long     used, peak, allocs, frees, nslabs;            ///< Pool statistics
+} SubPool; /* }}} */
+
 typedef struct subscreen_t /* {{{ */
 {
   FLAGS             flags;                                        ///< Screen flags
@@ -622,6 +683,9 @@ typedef struct subscreen_t /* {{{ */
   Drawable          drawable;                                     ///< Screen drawable
   Window            panel1, panel2;                               ///< Screen windows
   struct subarray_t *panels;                                      ///< Screen panels
+  struct subclient_t *focus;                                      ///< Screen last focus client
+  struct subindex_t *index;                                       ///< Screen visible clients sorted by center x
+  int               nindex, maxw;                                 ///< Screen index entries, widest entry
 
   /* FIXME: Cache ruby object during config */
   unsigned long     top, bottom;                                  ///< Screen panel values
@@ -636,9 +700,10 @@ typedef struct subseparator_t /* {{{ */
 typedef struct subsublet_t { /* {{{ */
   FLAGS             flags;                                        ///< Sublet flags
   int               watch, width, styleid;                        ///< Sublet watch id, width and style id
-  char              *name;                                        ///< Sublet name
+  char              *name, *path;                                 ///< Sublet name and file path
   unsigned long     instance;                                     ///< Sublet ruby instance, fg, bg and icon color
-  time_t            time, interval;                               ///< Sublet update/interval time
+  time_t            time, interval, mtime;                        ///< Sublet update/interval/file time
+  off_t             size;                                         ///< Sublet file size
 
   struct subtext_t  *text;                                        ///< Sublet text
 } SubSublet; /* }}} */
@@ -665,9 +730,12 @@ typedef struct subsubtle_t /* {{{ */
   FLAGS                flags;                                     ///< Subtle flags
 
   int                  loglevel, width, height;                   ///< Subtle loglevel and screen size
-  int                  ph, step, snap;                            ///< Subtle properties
-  int                  visible_tags, visible_views;               ///< Subtle visible tags and views
-  int                  client_tags, urgent_tags;                  ///< Subtle clients and urgent tags
+  int                  ph, step, snap, fps;                       ///< Subtle properties
+  unsigned long        frame;                                     ///< Subtle next panel frame
+  unsigned long        retag;                                     ///< Subtle next live retag
+  unsigned long        fontgen;                                   ///< Subtle font generation
+  TAGS                 visible_tags, visible_views;               ///< Subtle visible tags and views
+  TAGS                 client_tags, urgent_tags;                  ///< Subtle clients and urgent tags
   unsigned long        gravity;                                   ///< Subtle default gravity
 
   Display              *dpy;                                      ///< Subtle Xorg display
@@ -683,9 +751,13 @@ typedef struct subsubtle_t /* {{{ */
   struct subarray_t    *tags;                                     ///< Subtle tags
   struct subarray_t    *trays;                                    ///< Subtle trays
   struct subarray_t    *views;                                    ///< Subtle views
+  struct subarray_t    *removed;                                  ///< Subtle windows removed since last tile
+
+  struct subclient_t   *recent;                                   ///< Subtle focus history, most recent first
+  int                  nrecent;                                   ///< Subtle focus history length
 
 #ifdef HAVE_SYS_INOTIFY_H
-  int                  notify;                                    ///< Subtle inotify descriptor
+  int                  notify, watch;                             ///< Subtle inotify descriptor and sublets watch
 #endif /* HAVE_SYS_INOTIFY_H */
 
   struct
@@ -695,7 +767,7 @@ typedef struct subsubtle_t /* {{{ */
 
   struct
   {
-    Window             support, focus[HISTORYSIZE], tray;
+    Window             support, focus, tray;
   } windows;                                                      ///< Subtle windows
 
   struct
@@ -717,6 +789,11 @@ typedef struct subsubtle_t /* {{{ */
     GC                 stipple, invert, draw;
   } gcs;                                                          ///< Subtle graphic contexts
 
+  struct
+  {
+    struct subpool_t   *clients, *trays, *panels, *items;
+  } pools;                                                        ///< Subtle object pools
+
   struct
   {
     Cursor             arrow, move, resize;
@@ -739,12 +816,20 @@ typedef struct subtextitem_t /* {{{ */
   long            color;                                          ///< Text color
 
   union subdata_t data;                                           ///< Text data
+
+#ifdef HAVE_X11_XFT_XFT_H
+  XftFont         *xft;                                           ///< Text glyph font
+  unsigned long   fontgen;                                        ///< Text glyph font generation
+  FT_UInt         *glyphs;                                        ///< Text glyph indices
+  short           *advances;                                      ///< Text glyph advances
+  int             nglyphs;                                        ///< Text glyph count
+#endif /* HAVE_X11_XFT_XFT_H */
 } SubTextItem; /* }}} */
 
 typedef struct subtext_t /* {{{ */
 {
   struct subtextitem_t **items;                                   ///< Item text items
-  int                  flags, nitems, width;                      ///< Item flags, count, width
+  int                  flags, nitems, width, size;                ///< Item flags, count, width, capacity
 } SubText; /* }}} */
 
 typedef struct subtray_t /* {{{ */
@@ -763,6 +848,11 @@ typedef struct subview_t /* {{{ */
   TAGS              tags;                                         ///< View tags
   Window            focus;                                        ///< View window, focus
   int               width, styleid;                               ///< View width, style id
+  int               textwidth;                                    ///< View cached name width
+  unsigned long     fontgen;                                      ///< View font generation of name width
+  struct subfont_t  *font;                                        ///< View font of name width
+  int               layoutid, master;                             ///< View layout id, master clients
+  float             ratio;                                        ///< View layout ratio
 
   struct subicon_t  *icon;                                        ///< View icon
 } SubView; /* }}} */
@@ -775,6 +865,8 @@ SubArray *subArrayNew(void);                                      ///< Create ar
 void subArrayPush(SubArray *a, void *elem);                       ///< Push element to array
 void subArrayInsert(SubArray *a, int pos, void *elem);            ///< Insert element at pos
 void subArrayRemove(SubArray *a, void *elem);                     ///< Remove element from array
+void subArrayRemoveUnordered(SubArray *a, void *elem);            ///< Remove element without order
+void subArrayReserve(SubArray *a, int size);                      ///< Reserve room for elements
 void *subArrayGet(SubArray *a, int idx);                          ///< Get element
 int subArrayIndex(SubArray *a, void *elem);                       ///< Find array id of element
 void subArraySort(SubArray *a,                                    ///< Sort array with given compare function
@@ -811,6 +903,9 @@ void subClientSetType(SubClient *c, int *flags);                  ///< Set clien
 void subClientClose(SubClient *c);                                ///< Close client
 void subClientKill(SubClient *c);                                 ///< Kill client
 void subClientPublish(int restack);                               ///< Publish all clients
+void subClientPublishHistory(void);                               ///< Publish focus history
+int subClientLayout(int screenid);                                ///< Layout all clients of screen
+void subClientRetagLive(void);                                    ///< Retag clients with changed names
 /* }}} */
 
 /* display.c {{{ */
@@ -824,6 +919,11 @@ void subDisplayFinish(void);                                      ///< Kill disp
 /* event.c {{{ */
 void subEventWatchAdd(int fd);                                    ///< Add watch fd
 void subEventWatchDel(int fd);                                    ///< Del watch fd
+int subEventDirectMessage(Display *disp,
+  XClientMessageEvent *ev);                                       ///< Queue direct message
+void subEventDirectFlush(int all);                                ///< Handle queued direct messages
+char *subEventDirectProperty(Display *disp, Window win, Atom type,
+  Atom prop, unsigned long *size);                                ///< Get direct property
 void subEventLoop(void);                                          ///< Event loop
 void subEventFinish(void);                                        ///< Finish events
 /* }}} */
@@ -838,6 +938,8 @@ void subEwmhSetWindows(Window win, SubEwmh e,
   Window *values, int size);                                      ///< Set window properties
 void subEwmhSetCardinals(Window win, SubEwmh e,
   long *values, int size);                                        ///< Set cardinal properties
+void subEwmhSetTags(Window win, SubEwmh e,
+  TAGS *tags);                                                    ///< Set tags property
 void subEwmhSetString(Window win, SubEwmh e,
   char *value);                                                   ///< Set string property
 void subEwmhSetWMState(Window win, long state);                   ///< Set window WM state
@@ -846,6 +948,7 @@ void subEwmhTranslateClientMode(int client_flags, int *flags);    ///< Translate
 int subEwmhMessage(Window win, SubEwmh e, long mask,
   long data0, long data1, long data2, long data3,
   long data4);                                                    ///< Send message
+void subEwmhPublishNames(void);                                   ///< Publish hashed names
 void subEwmhFinish(void);                                         ///< Unset EWMH properties
 /* }}} */
 
@@ -870,34 +973,65 @@ void subGravityPublish(void);                                     ///< Publish g
 /* }}} */
 
 /* hook.c {{{ */
-SubHook *subHookNew(int type, unsigned long proc);                ///< Create hook
+SubHook *subHookNew(int type, unsigned long proc,
+  SubTag *filter);                                                ///< Create hook
 void subHookCall(int type, void *data);                           ///< Call hook
+int subHookCheck(int type);                                       ///< Check for hooks
 void subHookKill(SubHook *h);                                     ///< Kill hook
 /* }}} */
 
+/* index.c {{{ */
+void subIndexDirty(int screenid);                                 ///< Mark screen index outdated
+SubClient *subIndexSelect(SubClient *c, int direction);           ///< Find neighbor in direction
+SubClient *subIndexFind(int x, int y);                            ///< Find top client at point
+void subIndexSnap(SubClient *c, SubScreen *s, XRectangle *geom);  ///< Snap geom to neighbor edges
+/* }}} */
+
+/* layout.c {{{ */
+int subLayoutFind(const char *name);                              ///< Find layout id
+void subLayoutGeometry(SubView *v, XRectangle *area,
+  XRectangle *rects, int n);                                      ///< Calculate layout geometries
+/* }}} */
+
 /* panel.c {{{ */
 SubPanel *subPanelNew(int type);                                  ///< Create new panel
-void subPanelUpdate(SubPanel *p);                                 ///< Update panels
-void subPanelRender(SubPanel *p, Drawable drawable);              ///< Render panels
+int subPanelUpdate(SubPanel *p);                                  ///< Update panels
+void subPanelRender(SubPanel *p, Drawable drawable, int fill);    ///< Render panels
+void subPanelFlush(Drawable drawable);                            ///< Flush panel rects
 int subPanelCompare(const void *a, const void *b);                ///< Compare two panels
 void subPanelAction(SubArray *panels, int type, int x, int y,
   int button, int bottom);                                        ///< Handle panel action
 void subPanelGeometry(SubPanel *p, SubStyle *s,
   XRectangle *geom);                                              ///< Get panel geometry
 void subPanelPublish(void);                                       ///< Publish sublets
+void subPanelFinish(void);                                        ///< Free panel rects
 void subPanelKill(SubPanel *p);                                   ///< Kill panel
 /* }}} */
 
+/* pool.c {{{ */
+SubPool *subPoolNew(const char *name, size_t size,
+  int perslab);                                                   ///< Create pool
+void *subPoolAlloc(SubPool *p);                                   ///< Get object from pool
+void subPoolFree(SubPool *p, void *obj);                          ///< Return object to pool
+void subPoolStats(SubPool *p);                                    ///< Log pool statistics
+void subPoolPublish(void);                                        ///< Publish pool statistics
+void subPoolKill(SubPool *p);                                     ///< Kill pool
+/* }}} */
+
 /* ruby.c {{{ */
 void subRubyInit(void);                                           ///< Init Ruby stack
 void subRubyLoadConfig(void);                                     ///< Load config file
 void subRubyReloadConfig(void);                                   ///< Reload config file
 void subRubyLoadSublet(const char *file);                         ///< Load sublet
 void subRubyUnloadSublet(SubPanel *p);                            ///< Unload sublet
+void subRubyReloadSublet(const char *name);                       ///< Reload sublet
 void subRubyLoadSublets(void);                                    ///< Load sublets
 void subRubyLoadPanels(void);                                     ///< Load panels
 int subRubyCall(int type, unsigned long proc, void *data);        ///< Call Ruby script
 int subRubyRelease(unsigned long recv);                           ///< Release receiver
+void subRubyCollect(int wait);                                    ///< Collect garbage
+void subRubyProxyKill(unsigned long win);                         ///< Drop client proxy
+void subRubyIconFlush(Pixmap pixmap);                             ///< Drop colorized icon copies
 void subRubyFinish(void);                                         ///< Kill Ruby stack
 /* }}} */
 
@@ -908,8 +1042,10 @@ SubScreen *subScreenNew(int x, int y, unsigned int width,
 SubScreen *subScreenFind(int x, int y, int *sid);                 ///< Find screen by coordinates
 SubScreen * subScreenCurrent(int *sid);                           ///< Get current screen
 void subScreenConfigure(void);                                    ///< Configure screens
+void subScreenTile(void);                                         ///< Call tile hook with changes
 void subScreenUpdate(void);                                       ///< Update screens
 void subScreenRender(void);                                       ///< Render screens
+void subScreenSchedule(void);                                     ///< Schedule screen render
 void subScreenResize(void);                                       ///< Update screen sizes
 void subScreenWarp(SubScreen *s);                                 ///< Warp pointer to screen
 void subScreenPublish(void);                                      ///< Publish screens
@@ -928,6 +1064,7 @@ void subStyleUpdate(void);                                        ///< Update va
 /* subtle.c {{{ */
 XPointer * subSubtleFind(Window win, XContext id);                ///< Find window
 time_t subSubtleTime(void);                                       ///< Get current time
+unsigned long subSubtleTicks(void);                               ///< Get current ticks
 void subSubtleLog(int level, const char *file,
   int line, const char *format, ...);                             ///< Print messages
 void subSubtleFinish(void);                                       ///< Finish subtle
@@ -938,6 +1075,9 @@ SubTag *subTagNew(char *name, int *duplicate);                    ///< Create ta
 void subTagMatcherAdd(SubTag *t, int type,
   char *pattern, int and);                                        ///< Add a matcher
 int subTagMatcherCheck(SubTag *t, SubClient *c);                  ///< Check for match
+TAGS subTagMatcherTags(SubClient *c);                             ///< Check all tags at once
+TAGS subTagMatcherLive(void);                                     ///< Get tags with live retag
+void subTagMatcherClear(SubTag *t);                               ///< Clear matcher
 void subTagPublish(void);                                         ///< Publish tags
 void subTagKill(SubTag *t);                                       ///< Delete tag
 /* }}} */
@@ -947,6 +1087,7 @@ SubText *subTextNew(void);                                         ///< Create t
 int subTextParse(SubText *t, SubFont *f, char *text);             ///< Parse string
 void subTextRender(SubText *t, SubFont *f, GC gc, Window win,
   int x, int y, long fg, long icon, long bg);                     ///< Render text
+void subTextFlush(void);                                          ///< Invalidate glyph caches
 void subTextKill(SubText *t);                                     ///< Delete text
 /* }}} */
 
@@ -964,6 +1105,7 @@ void subTrayPublish(void);                                        ///< Publish t
 
 /* view.c {{{ */
 SubView *subViewNew(char *name, char *tags);                      ///< Create view
+void subViewTags(SubView *v, char *tags);                         ///< Set view tags
 void subViewFocus(SubView *v, int screenid,
   int swap, int focus);                                           ///< Focus view
 void subViewKill(SubView *v);                                     ///< Kill view
@@ -10,17 +10,46 @@
   * See the file COPYING for details.
   **/
 
+#include <ctype.h>
+#include <X11/Xresource.h>
 #include "subtle.h"
 
 #define MATCHER(m) ((TagMatcher *)m)
 
+#define TAGCACHE    64  ///< Tagging cache buckets
+#define TAGCACHEMAX 512 ///< Tagging cache entries before flush
+
 /* Typedef {{{ */
 typedef struct tagmatcher_t
 {
   FLAGS               flags;
-  struct tagmatcher_t *and;
+  int                 tagid, id, len;
+  struct tagmatcher_t *and, *next;
   regex_t             *regex;
+  char                *literal;
 } TagMatcher;
+
+typedef struct tagcache_t
+{
+  FLAGS             type;
+  TAGS              tags;
+  unsigned long     hash;
+  char              *instance, *klass, *role;
+  struct tagcache_t *next;
+} TagCache;
+
+typedef struct tagindex_t
+{
+  int        ntags, nmatchers, maxlen, nbuckets, ncache;
+  TAGS       named, live;
+  char       *lengths, *hits;
+  TagMatcher **buckets, **matchers;
+  TagCache   *cache[TAGCACHE];
+} TagIndex;
+/* }}} */
+
+/* Globals {{{ */
+static TagIndex *tindex = NULL; ///< Compiled matchers of all tags
 /* }}} */
 
 /* Private */
@@ -38,7 +67,8 @@ TagClear(SubTag *t)
     {
       TagMatcher *m = (TagMatcher *)t->matcher->data[i];
 
-      if(m->regex) subSharedRegexKill(m->regex);
+      if(m->regex)   subSharedRegexKill(m->regex);
+      if(m->literal) free(m->literal);
 
       free(m);
     }
@@ -50,20 +80,10 @@ TagClear(SubTag *t)
 static SubTag *
 TagFind(char *name)
 {
-  int i;
-  SubTag *t = NULL;
-
   assert(name);
 
-  /* Linear search */
-  for(i = 0; i < subtle->tags->ndata; i++)
-    {
-      t = TAG(subtle->tags->data[i]);
-
-      if(0 == strcmp(t->name, name)) return t;
-    }
-
-  return NULL;
+  /* Lookup registered name */
+  return TAG(subSubtleFind((Window)XrmStringToQuark(name), TAGID));
 } /* }}} */
 
 /* TagMatch {{{ */
@@ -93,6 +113,262 @@ TagMatch(TagMatcher *m,
   return False;
 } /* }}} */
 
+/* TagHash {{{ */
+static unsigned long
+TagHash(unsigned long hash,
+  char c)
+{
+  /* FNV-1a step */
+  return (hash ^ (unsigned char)c) * 16777619UL;
+} /* }}} */
+
+/* TagLiteral {{{ */
+static char *
+TagLiteral(char *pattern)
+{
+  int i;
+  char *literal = NULL;
+
+  /* Plain words need no regex: onig_match anchors at the start and
+   * ignores case, so they just match as case-less prefix. Empty
+   * patterns match anything and stay regex */
+  if(!*pattern) return NULL;
+
+  for(i = 0; pattern[i]; i++)
+    if(!isalnum((unsigned char)pattern[i]) &&
+        '_' != pattern[i] && '-' != pattern[i])
+      return NULL;
+
+  literal = strdup(pattern);
+
+  for(i = 0; literal[i]; i++)
+    literal[i] = tolower((unsigned char)literal[i]);
+
+  return literal;
+} /* }}} */
+
+/* TagCacheClear {{{ */
+static void
+TagCacheClear(void)
+{
+  int i;
+
+  for(i = 0; i < TAGCACHE; i++)
+    {
+      TagCache *e = tindex->cache[i], *next = NULL;
+
+      for(; e; e = next)
+        {
+          next = e->next;
+
+          if(e->role) free(e->role);
+          free(e);
+        }
+
+      tindex->cache[i] = NULL;
+    }
+
+  tindex->ncache = 0;
+} /* }}} */
+
+/* TagCacheHash {{{ */
+static unsigned long
+TagCacheHash(SubClient *c,
+  FLAGS type)
+{
+  int i;
+  unsigned long hash = 2166136261UL;
+  char *strs[] = { c->instance, c->klass };
+
+  /* Interned strings are equal when pointers are */
+  for(i = 0; i < LENGTH(strs); i++)
+    hash = (hash ^ ((unsigned long)strs[i] >> 3)) * 16777619UL;
+
+  /* Roles are not interned */
+  if(c->role) hash = (hash ^ (unsigned long)subSharedStringHash(c->role)) * 16777619UL;
+
+  return hash ^ type;
+} /* }}} */
+
+/* TagCacheFind {{{ */
+static TagCache *
+TagCacheFind(SubClient *c,
+  FLAGS type,
+  unsigned long hash)
+{
+  TagCache *e = tindex->cache[hash % TAGCACHE];
+
+  for(; e; e = e->next)
+    {
+      if(e->hash == hash && e->type == type &&
+          e->instance == c->instance && e->klass == c->klass &&
+          (e->role == c->role || (e->role && c->role &&
+          0 == strcmp(e->role, c->role))))
+        return e;
+    }
+
+  return NULL;
+} /* }}} */
+
+/* TagCacheStore {{{ */
+static void
+TagCacheStore(SubClient *c,
+  FLAGS type,
+  unsigned long hash,
+  TAGS tags)
+{
+  TagCache *e = NULL;
+
+  /* Start over when too many different windows were seen */
+  if(TAGCACHEMAX <= tindex->ncache) TagCacheClear();
+
+  e = (TagCache *)subSharedMemoryAlloc(1, sizeof(TagCache));
+  e->type     = type;
+  e->tags     = tags;
+  e->hash     = hash;
+  e->instance = c->instance;
+  e->klass    = c->klass;
+  e->role     = c->role ? strdup(c->role) : NULL;
+  e->next     = tindex->cache[hash % TAGCACHE];
+
+  tindex->cache[hash % TAGCACHE] = e;
+  tindex->ncache++;
+} /* }}} */
+
+/* TagIndexClear {{{ */
+static void
+TagIndexClear(void)
+{
+  if(tindex)
+    {
+      TagCacheClear();
+
+      if(tindex->lengths)  free(tindex->lengths);
+      if(tindex->hits)     free(tindex->hits);
+      if(tindex->buckets)  free(tindex->buckets);
+      if(tindex->matchers) free(tindex->matchers);
+
+      free(tindex);
+
+      tindex = NULL;
+    }
+} /* }}} */
+
+/* TagIndexCompile {{{ */
+static void
+TagIndexCompile(void)
+{
+  int i, j, n = 0;
+
+  tindex = (TagIndex *)subSharedMemoryAlloc(1, sizeof(TagIndex));
+  tindex->ntags = subtle->tags->ndata;
+
+  /* Count matchers and longest literal */
+  for(i = 0; i < subtle->tags->ndata; i++)
+    {
+      SubTag *t = TAG(subtle->tags->data[i]);
+
+      for(j = 0; t->matcher && j < t->matcher->ndata; j++)
+        {
+          TagMatcher *m = MATCHER(t->matcher->data[j]);
+
+          if(m->literal) tindex->maxlen = MAX(tindex->maxlen, m->len);
+
+          n++;
+        }
+    }
+
+  tindex->nmatchers = n;
+  tindex->nbuckets  = 2 * n + 1;
+  tindex->matchers  = (TagMatcher **)subSharedMemoryAlloc(n + 1,
+    sizeof(TagMatcher *));
+  tindex->buckets   = (TagMatcher **)subSharedMemoryAlloc(tindex->nbuckets,
+    sizeof(TagMatcher *));
+  tindex->hits      = (char *)subSharedMemoryAlloc(n + 1, sizeof(char));
+  tindex->lengths   = (char *)subSharedMemoryAlloc(tindex->maxlen + 1,
+    sizeof(char));
+
+  /* Number matchers and hash literals */
+  for(i = 0, n = 0; i < subtle->tags->ndata; i++)
+    {
+      SubTag *t = TAG(subtle->tags->data[i]);
+
+      for(j = 0; t->matcher && j < t->matcher->ndata; j++)
+        {
+          TagMatcher *m = MATCHER(t->matcher->data[j]);
+
+          m->id                 = n;
+          m->tagid              = i;
+          m->next               = NULL;
+          tindex->matchers[n++] = m;
+
+          /* Window names change, so these results can't be cached */
+          if(m->flags & SUB_TAG_MATCH_NAME)
+            {
+              subSharedTagsSet(&tindex->named, i);
+
+              if(t->flags & SUB_TAG_RETAG) subSharedTagsSet(&tindex->live, i);
+            }
+
+          if(m->literal)
+            {
+              int k;
+              unsigned long hash = 2166136261UL;
+
+              for(k = 0; k < m->len; k++) hash = TagHash(hash, m->literal[k]);
+
+              m->next = tindex->buckets[hash % tindex->nbuckets];
+              tindex->buckets[hash % tindex->nbuckets] = m;
+              tindex->lengths[m->len] = True;
+            }
+        }
+    }
+} /* }}} */
+
+/* TagIndexCheck {{{ */
+static void
+TagIndexCheck(void)
+{
+  /* Compile matchers on first use after changes */
+  if(tindex && tindex->ntags != subtle->tags->ndata) TagIndexClear();
+  if(!tindex) TagIndexCompile();
+} /* }}} */
+
+/* TagIndexField {{{ */
+static void
+TagIndexField(int field,
+  char *str,
+  TAGS *want)
+{
+  int i;
+  unsigned long hash = 2166136261UL;
+
+  /* Hash every prefix that has literals of this length */
+  for(i = 0; str[i] && i < tindex->maxlen; i++)
+    {
+      hash = TagHash(hash, tolower((unsigned char)str[i]));
+
+      if(tindex->lengths[i + 1])
+        {
+          TagMatcher *m = tindex->buckets[hash % tindex->nbuckets];
+
+          for(; m; m = m->next)
+            {
+              int k;
+
+              if(m->len != i + 1 || !(m->flags & field) ||
+                  (want && !subSharedTagsTest(want, m->tagid)))
+                continue;
+
+              for(k = 0; k <= i &&
+                tolower((unsigned char)str[k]) == m->literal[k]; k++);
+
+              if(k > i) tindex->hits[m->id] = True;
+            }
+        }
+    }
+} /* }}} */
+
 /* Public */
 
  /** subTagNew {{{
@@ -121,7 +397,15 @@ subTagNew(char *name,
       t = TAG(subSharedMemoryAlloc(1, sizeof(SubTag)));
       t->flags = SUB_TYPE_TAG;
       t->name  = strdup(name);
-      if(duplicate) *duplicate = False;
+
+      /* Register name of real tags */
+      if(duplicate)
+        {
+          XSaveContext(subtle->dpy, (XID)XrmStringToQuark(name),
+            TAGID, (void *)t);
+
+          *duplicate = False;
+        }
     }
 
   subSubtleLogDebugSubtle("New: name=%s\n", name);
@@ -165,6 +449,12 @@ subTagMatcherAdd(SubTag *t,
       m->flags = type;
       m->regex = regex;
 
+      /* Plain words are matched via index */
+      if(regex && (m->literal = TagLiteral(pattern)))
+        m->len = strlen(m->literal);
+
+      TagIndexClear();
+
       /* Create on demand to safe memory */
       if(NULL == t->matcher) t->matcher = subArrayNew();
       else if(and && 0 < t->matcher->ndata)
@@ -220,26 +510,157 @@ subTagMatcherCheck(SubTag *t,
   return False;
 } /* }}} */
 
- /** subTagKill {{{
-  * @brief Delete tag
+ /** subTagMatcherTags {{{
+  * @brief Check all tags at once
+  * @param[in]  c  A #SubClient
+  * @return Tags of all matching tags
+  **/
+
+TAGS
+subTagMatcherTags(SubClient *c)
+{
+  int i, j;
+  unsigned long hash = 0;
+  TAGS tags, *want = NULL;
+  FLAGS type = (c->flags & (SUB_CLIENT_TYPE_NORMAL|TYPES_ALL));
+  TagCache *e = NULL;
+
+  assert(c);
+
+  TagIndexCheck();
+
+  /* Windows of the same kind share results, just check name matchers */
+  hash = TagCacheHash(c, type);
+
+  if((e = TagCacheFind(c, type, hash)))
+    {
+      want = &tindex->named;
+
+      if(subSharedTagsEmpty(want)) return e->tags;
+    }
+
+  subSharedTagsClear(&tags);
+
+  memset(tindex->hits, 0, tindex->nmatchers);
+
+  /* Pass 1: Plain words via prefix hashes */
+  if(0 < tindex->maxlen)
+    {
+      if(c->name)     TagIndexField(SUB_TAG_MATCH_NAME,     c->name,     want);
+      if(c->instance) TagIndexField(SUB_TAG_MATCH_INSTANCE, c->instance, want);
+      if(c->klass)    TagIndexField(SUB_TAG_MATCH_CLASS,    c->klass,    want);
+      if(c->role)     TagIndexField(SUB_TAG_MATCH_ROLE,     c->role,     want);
+    }
+
+  /* Pass 2: Real patterns and types */
+  for(i = 0; i < tindex->nmatchers; i++)
+    {
+      TagMatcher *m = tindex->matchers[i];
+
+      if(tindex->hits[i] || (want && !subSharedTagsTest(want, m->tagid)))
+        continue;
+
+      if(m->literal)
+        {
+          if(m->flags & SUB_TAG_MATCH_TYPE &&
+              c->flags & (m->flags & (SUB_CLIENT_TYPE_NORMAL|TYPES_ALL)))
+            tindex->hits[i] = True;
+        }
+      else tindex->hits[i] = TagMatch(m, c);
+    }
+
+  /* Pass 3: Resolve AND chains per tag */
+  for(i = 0; i < subtle->tags->ndata; i++)
+    {
+      SubTag *t = TAG(subtle->tags->data[i]);
+
+      if(want && !subSharedTagsTest(want, i)) continue;
+
+      for(j = 0; t->matcher && j < t->matcher->ndata; j++)
+        {
+          TagMatcher *m = MATCHER(t->matcher->data[j]);
+
+          if(!(m->flags & SUB_TAG_MATCH_AND))
+            {
+              TagMatcher *cur = m;
+
+              while(cur && tindex->hits[cur->id]) cur = cur->and;
+
+              if(!cur)
+                {
+                  subSharedTagsSet(&tags, i);
+                  break;
+                }
+            }
+        }
+    }
+
+  if(e) subSharedTagsOr(&tags, &e->tags);
+  else
+    {
+      TAGS cache = tags;
+
+      subSharedTagsAndNot(&cache, &tindex->named);
+      TagCacheStore(c, type, hash, cache);
+    }
+
+  return tags;
+} /* }}} */
+
+ /** subTagMatcherLive {{{
+  * @brief Get tags that are checked again on name changes
+  * @return Tags with live retag and name matchers
+  **/
+
+TAGS
+subTagMatcherLive(void)
+{
+  TagIndexCheck();
+
+  return tindex->live;
+} /* }}} */
+
+ /** subTagMatcherClear {{{
+  * @brief Remove all matchers of a tag
   * @param[in]  t  A #SubTag
   **/
 
 void
-subTagKill(SubTag *t)
+subTagMatcherClear(SubTag *t)
 {
   assert(t);
 
-  /* Hook: Kill */
-  subHookCall((SUB_HOOK_TYPE_TAG|SUB_HOOK_ACTION_KILL),
-    (void *)t);
-
-  /* Remove matcher */
   if(t->matcher)
     {
+      TagIndexClear();
       TagClear(t);
       subArrayKill(t->matcher, False);
+
+      t->matcher = NULL;
     }
+} /* }}} */
+
+ /** subTagKill {{{
+  * @brief Delete tag
+  * @param[in]  t  A #SubTag
+  **/
+
+void
+subTagKill(SubTag *t)
+{
+  assert(t);
+
+  /* Hook: Kill, skip hook filters */
+  if(subtle->tags && 0 <= subArrayIndex(subtle->tags, (void *)t))
+    subHookCall((SUB_HOOK_TYPE_TAG|SUB_HOOK_ACTION_KILL),
+      (void *)t);
+
+  TagIndexClear();
+  subTagMatcherClear(t);
+
+  /* Unregister name */
+  if(t == TagFind(t->name))
+    XDeleteContext(subtle->dpy, (XID)XrmStringToQuark(t->name), TAGID);
 
   /* Remove proc */
   if(t->flags & SUB_TAG_PROC)
@@ -273,6 +694,7 @@ subTagPublish(void)
   /* EWMH: Tag list */
   subSharedPropertySetStrings(subtle->dpy, ROOT,
     subEwmhGet(SUB_EWMH_SUBTLE_TAG_LIST), names, i);
+  subEwmhPublishNames();
 
   XSync(subtle->dpy, False); ///< Sync all changes
 
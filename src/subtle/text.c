@@ -12,6 +12,205 @@
 
 #include "subtle.h"
 
+#ifdef HAVE_X11_XFT_XFT_H
+/* Typedef {{{ */
+typedef struct textrun_t
+{
+  long color;
+  int  start, len;
+} TextRun;
+/* }}} */
+
+/* Globals {{{ */
+static XftGlyphFontSpec *specs = NULL;
+static TextRun *runs = NULL;
+static int nspecs = 0, nruns = 0;
+/* }}} */
+
+/* Private */
+
+/* TextGlyphsClear {{{ */
+static void
+TextGlyphsClear(SubTextItem *item)
+{
+  if(item->glyphs)   free(item->glyphs);
+  if(item->advances) free(item->advances);
+
+  item->xft      = NULL;
+  item->fontgen  = 0;
+  item->glyphs   = NULL;
+  item->advances = NULL;
+  item->nglyphs  = 0;
+} /* }}} */
+
+/* TextGlyphs {{{ */
+static void
+TextGlyphs(SubTextItem *item,
+  XftFont *xft)
+{
+  int len = 0, pos = 0, nbytes = 0;
+  FcChar32 ucs4 = 0;
+  XGlyphInfo info;
+
+  /* Glyphs are cached until string or font change; fonts can be
+   * reallocated at the same address after a reset */
+  if(item->xft == xft && item->fontgen == subtle->fontgen) return;
+
+  TextGlyphsClear(item);
+
+  len            = strlen(item->data.string);
+  item->xft      = xft;
+  item->fontgen  = subtle->fontgen;
+  item->glyphs   = (FT_UInt *)subSharedMemoryAlloc(len + 1, sizeof(FT_UInt));
+  item->advances = (short *)subSharedMemoryAlloc(len + 1, sizeof(short));
+
+  /* Convert utf8 chars to glyph indices */
+  while(pos < len && 0 < (nbytes = FcUtf8ToUcs4(
+      (FcChar8 *)item->data.string + pos, &ucs4, len - pos)))
+    {
+      item->glyphs[item->nglyphs] = XftCharIndex(subtle->dpy, xft, ucs4);
+
+      XftGlyphExtents(subtle->dpy, xft, &item->glyphs[item->nglyphs],
+        1, &info);
+
+      item->advances[(item->nglyphs)++] = info.xOff;
+      pos += nbytes;
+    }
+} /* }}} */
+
+/* TextRunAdd {{{ */
+static void
+TextRunAdd(long color,
+  int len)
+{
+  int i;
+
+  /* Append to run of same color */
+  for(i = 0; i < nruns; i++)
+    {
+      if(runs[i].color == color)
+        {
+          runs[i].len += len;
+
+          return;
+        }
+    }
+
+  runs = (TextRun *)subSharedMemoryRealloc(runs,
+    (nruns + 1) * sizeof(TextRun));
+
+  runs[nruns].color = color;
+  runs[nruns].start = 0;
+  runs[nruns++].len = len;
+} /* }}} */
+
+/* TextDrawRuns {{{ */
+static void
+TextDrawRuns(SubText *t,
+  SubFont *f,
+  Window win,
+  int x,
+  int y,
+  long fg)
+{
+  int i, j, total = 0, width = x;
+
+  nruns = 0;
+
+  /* Pass 1: Convert strings and count glyphs per color */
+  for(i = 0; i < t->nitems; i++)
+    {
+      SubTextItem *item = ITEM(t->items[i]);
+
+      if(item->flags & SUB_TEXT_EMPTY) break;
+      if(item->flags & (SUB_TEXT_BITMAP|SUB_TEXT_PIXMAP)) continue;
+
+      TextGlyphs(item, f->xft);
+      TextRunAdd(-1 == item->color ? fg : item->color, item->nglyphs);
+
+      total += item->nglyphs;
+    }
+
+  if(0 == total) return;
+
+  /* Grow spec buffer */
+  if(total > nspecs)
+    {
+      specs  = (XftGlyphFontSpec *)subSharedMemoryRealloc(specs,
+        total * sizeof(XftGlyphFontSpec));
+      nspecs = total;
+    }
+
+  /* Set start offsets of runs */
+  for(i = 1; i < nruns; i++)
+    runs[i].start = runs[i - 1].start + runs[i - 1].len;
+  for(i = 0; i < nruns; i++)
+    runs[i].len = 0;
+
+  /* Pass 2: Position glyphs and sort them into runs */
+  for(i = 0; i < t->nitems; i++)
+    {
+      SubTextItem *item = ITEM(t->items[i]);
+
+      if(item->flags & SUB_TEXT_EMPTY) break;
+      if(item->flags & (SUB_TEXT_BITMAP|SUB_TEXT_PIXMAP))
+        {
+          int dx = (0 == i) ? 0 : 3;
+
+          width += item->width + dx + (i != t->nitems - 1 ? 3 : 0);
+        }
+      else
+        {
+          int gx = width;
+          long color = -1 == item->color ? fg : item->color;
+          TextRun *run = NULL;
+
+          for(j = 0; j < nruns; j++)
+            if(runs[j].color == color) run = &runs[j];
+
+          for(j = 0; j < item->nglyphs; j++)
+            {
+              XftGlyphFontSpec *spec = &specs[run->start + run->len++];
+
+              spec->font  = f->xft;
+              spec->glyph = item->glyphs[j];
+              spec->x     = gx;
+              spec->y     = y;
+
+              gx += item->advances[j];
+            }
+
+          width += item->width;
+        }
+    }
+
+  XftDrawChange(f->draw, win);
+
+  /* Submit one request per color */
+  for(i = 0; i < nruns; i++)
+    {
+      XftColor color = { 0 };
+      XColor xcolor = { 0 };
+
+      /* Get color values */
+      xcolor.pixel = runs[i].color;
+      XQueryColor(subtle->dpy, DefaultColormap(subtle->dpy,
+        DefaultScreen(subtle->dpy)), &xcolor);
+
+      color.pixel       = xcolor.pixel;
+      color.color.red   = xcolor.red;
+      color.color.green = xcolor.green;
+      color.color.blue  = xcolor.blue;
+      color.color.alpha = 0xffff;
+
+      XftDrawGlyphFontSpec(f->draw, &color, specs + runs[i].start,
+        runs[i].len);
+    }
+} /* }}} */
+#endif /* HAVE_X11_XFT_XFT_H */
+
+/* Public */
+
  /** subTextNew {{{
   * @brief Create new text
   **/
@@ -35,7 +234,7 @@ subTextParse(SubText *t,
   SubFont *f,
   char *text)
 {
-  int i = 0, left = 0, right = 0;
+  int i = 0, left = 0, right = 0, same = False;
   char *tok = NULL;
   long color = -1, pixmap = 0;
   SubTextItem *item = NULL;
@@ -51,19 +250,34 @@ subTextParse(SubText *t,
       else if('\0' != *tok) ///< Text or icon
         {
           /* Re-use items to save alloc cycles */
+          same = False;
+
           if(i < t->nitems && (item = ITEM(t->items[i])))
             {
+              /* Keep string and glyphs of unchanged text */
               if(!(item->flags & (SUB_TEXT_BITMAP|SUB_TEXT_PIXMAP)) &&
                   item->data.string)
-                free(item->data.string);
+                {
+                  if(!(same = (0 == strcmp(item->data.string, tok))))
+                    free(item->data.string);
+                }
+
+#ifdef HAVE_X11_XFT_XFT_H
+              if(!same) TextGlyphsClear(item);
+#endif /* HAVE_X11_XFT_XFT_H */
 
               item->flags &= ~(SUB_TEXT_EMPTY|SUB_TEXT_BITMAP|SUB_TEXT_PIXMAP);
             }
-          else if((item = ITEM(subSharedMemoryAlloc(1, sizeof(SubTextItem)))))
+          else if((item = ITEM(subPoolAlloc(subtle->pools.items))))
             {
-              /* Add icon to array */
-              t->items = (SubTextItem **)subSharedMemoryRealloc(t->items,
-                (t->nitems + 1) * sizeof(SubTextItem *));
+              /* Grow array geometrically */
+              if(t->nitems == t->size)
+                {
+                  t->size  = 0 < t->size ? 2 * t->size : 4;
+                  t->items = (SubTextItem **)subSharedMemoryRealloc(t->items,
+                    t->size * sizeof(SubTextItem *));
+                }
+
               t->items[(t->nitems)++] = item;
             }
 
@@ -88,7 +302,7 @@ subTextParse(SubText *t,
             }
           else ///< Ordinary text
             {
-              item->data.string = strdup(tok);
+              if(!same) item->data.string = strdup(tok);
               item->width       = subSharedStringWidth(subtle->dpy, f, tok,
                 strlen(tok), &left, &right, False);
 
@@ -149,6 +363,11 @@ subTextRender(SubText *t,
 
   assert(t);
 
+#ifdef HAVE_X11_XFT_XFT_H
+  /* Draw all text items as glyph runs per color */
+  if(f->xft) TextDrawRuns(t, f, win, x, y, fg);
+#endif /* HAVE_X11_XFT_XFT_H */
+
   /* Render text items */
   for(i = 0; i < t->nitems; i++)
     {
@@ -174,15 +393,28 @@ subTextRender(SubText *t,
         }
       else ///< Text
         {
-          subSharedDrawString(subtle->dpy, gc, f, win, width, y,
-            (-1 == item->color) ? fg : item->color, bg, 
-            item->data.string, strlen(item->data.string));
+#ifdef HAVE_X11_XFT_XFT_H
+          if(!f->xft) ///< Already drawn as glyph runs
+#endif /* HAVE_X11_XFT_XFT_H */
+            subSharedDrawString(subtle->dpy, gc, f, win, width, y,
+              (-1 == item->color) ? fg : item->color, bg,
+              item->data.string, strlen(item->data.string));
 
           width += item->width;
         }
     }
 } /* }}} */
 
+ /** subTextFlush {{{
+  * @brief Invalidate glyph and width caches after fonts were reset
+  **/
+
+void
+subTextFlush(void)
+{
+  subtle->fontgen++;
+} /* }}} */
+
  /** subTextKill {{{
   * @brief Delete text
   * @param[in]  t  A #SubText
@@ -203,7 +435,11 @@ subTextKill(SubText *t)
           item->data.string)
         free(item->data.string);
 
-      free(t->items[i]);
+#ifdef HAVE_X11_XFT_XFT_H
+      TextGlyphsClear(item);
+#endif /* HAVE_X11_XFT_XFT_H */
+
+      subPoolFree(subtle->pools.items, t->items[i]);
     }
 
   free(t->items);
@@ -28,7 +28,7 @@ subTrayNew(Window win)
   assert(win);
 
   /* Create new tray */
-  t = TRAY(subSharedMemoryAlloc(1, sizeof(SubTray)));
+  t = TRAY(subPoolAlloc(subtle->pools.trays));
   t->flags = SUB_TYPE_TRAY;
   t->win   = win;
   t->width = subtle->ph; ///< Default width
@@ -108,6 +108,8 @@ subTrayConfigure(SubTray *t)
 void
 subTrayUpdate(void)
 {
+  int width = subtle->panels.tray.width;
+
   subtle->panels.tray.width = 0; ///< Reset width
 
   if(0 < subtle->trays->ndata)
@@ -134,6 +136,15 @@ subTrayUpdate(void)
         subtle->panels.tray.width, subtle->ph);
     }
   else XUnmapWindow(subtle->dpy, subtle->windows.tray);
+
+  /* Tray width isn't measured by subPanelUpdate */
+  if(width != subtle->panels.tray.width)
+    {
+      int i;
+
+      for(i = 0; i < subtle->screens->ndata; i++)
+        SCREEN(subtle->screens->data[i])->flags |= SUB_SCREEN_REFLOW;
+    }
 } /* }}} */
 
  /** subTraySetState {{{
@@ -233,7 +244,7 @@ subTrayClose(SubTray *t)
     }
   else
     {
-      int focus = (subtle->windows.focus[0] == t->win); ///< Save
+      int focus = (subtle->windows.focus == t->win); ///< Save
 
       /* Kill it manually */
       XKillClient(subtle->dpy, t->win);
@@ -277,7 +288,7 @@ subTrayKill(SubTray *t)
   XMapRaised(subtle->dpy, t->win);
 
   if(t->name) free(t->name);
-  free(t);
+  subPoolFree(subtle->pools.trays, t);
 
   subSubtleLogDebugSubtle("Kill\n");
 } /* }}} */
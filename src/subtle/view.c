@@ -29,9 +29,33 @@ subViewNew(char *name,
 
   /* Create new view */
   v = VIEW(subSharedMemoryAlloc(1, sizeof(SubView)));
-  v->flags = SUB_TYPE_VIEW;
-  v->styleid = -1;
-  v->name  = strdup(name);
+  v->flags    = SUB_TYPE_VIEW;
+  v->styleid  = -1;
+  v->layoutid = -1;
+  v->master   = 1;
+  v->ratio    = 0.5;
+  v->name     = strdup(name);
+
+  subViewTags(v, tags);
+
+  subSubtleLogDebugSubtle("New: name=%s\n", name);
+
+  return v;
+} /* }}} */
+
+ /** subViewTags {{{
+  * @brief Set view tags from regex
+  * @param[in]  v     A #SubView
+  * @param[in]  tags  Tags for the view
+  **/
+
+void
+subViewTags(SubView *v,
+  char *tags)
+{
+  assert(v);
+
+  subSharedTagsClear(&v->tags);
 
   /* Tags */
   if(tags && strncmp("", tags, 1))
@@ -41,14 +65,12 @@ subViewNew(char *name,
 
       for(i = 0; i < subtle->tags->ndata; i++)
         if(subSharedRegexMatch(preg, TAG(subtle->tags->data[i])->name))
-          v->tags |= (1L << (i + 1));
+          subSharedTagsSet(&v->tags, i);
 
       subSharedRegexKill(preg);
     }
 
-  subSubtleLogDebugSubtle("New: name=%s\n", name);
-
-  return v;
+  subSubtleLogDebugSubtle("Tags: name=%s\n", v->name);
 } /* }}} */
 
  /** subViewFocus {{{
@@ -76,7 +98,7 @@ subViewFocus(SubView *v,
   vid = subArrayIndex(subtle->views, (void *)v);
 
   /* Check if view is visible on any screen */
-  if(subtle->visible_views & (1L << (vid + 1)))
+  if(subSharedTagsTest(&subtle->visible_views, vid))
     {
       /* This only makes sense with more than one screen
        * otherwise just ignore that */
@@ -167,7 +189,8 @@ subViewPublish(void)
 
   if(0 < subtle->views->ndata)
     {
-      tags  = (long *)subSharedMemoryAlloc(subtle->views->ndata, sizeof(long));
+      tags  = (long *)subSharedMemoryAlloc(subtle->views->ndata * TAGSCARDS,
+        sizeof(long));
       icons = (long *)subSharedMemoryAlloc(subtle->views->ndata, sizeof(long));
       names = (char **)subSharedMemoryAlloc(subtle->views->ndata, sizeof(char *));
 
@@ -175,14 +198,15 @@ subViewPublish(void)
         {
           SubView *v = VIEW(subtle->views->data[i]);
 
-          tags[i]  = v->tags;
           icons[i] = v->icon ? v->icon->pixmap : -1;
           names[i] = v->name;
+
+          subSharedTagsToCards(&v->tags, tags + i * TAGSCARDS);
         }
 
-      /* EWMH: Tags */
+      /* EWMH: Tags, fixed number of cardinals per view */
       subEwmhSetCardinals(ROOT, SUB_EWMH_SUBTLE_VIEW_TAGS,
-        tags, subtle->views->ndata);
+        tags, subtle->views->ndata * TAGSCARDS);
 
       /* EWMH: Icons */
       subEwmhSetCardinals(ROOT, SUB_EWMH_SUBTLE_VIEW_ICONS,
@@ -192,6 +216,7 @@ subViewPublish(void)
       subEwmhSetCardinals(ROOT, SUB_EWMH_NET_NUMBER_OF_DESKTOPS, (long *)&i, 1);
       subSharedPropertySetStrings(subtle->dpy, ROOT,
         subEwmhGet(SUB_EWMH_NET_DESKTOP_NAMES), names, subtle->views->ndata);
+      subEwmhPublishNames();
 
       /* EWMH: Current desktop */
       subEwmhSetCardinals(ROOT, SUB_EWMH_NET_CURRENT_DESKTOP, &vid, 1);
@@ -353,7 +353,7 @@ subextClientSingVisible(VALUE self)
 {
   int i, nclients = 0;
   Window *clients = NULL;
-  unsigned long *visible = NULL;
+  SubTags visible;
   VALUE meth = Qnil, klass = Qnil, array = Qnil, client = Qnil;
 
   subextSubtlextConnect(NULL); ///< Implicit open connection
@@ -363,33 +363,27 @@ subextClientSingVisible(VALUE self)
   array   = rb_ary_new();
   klass   = rb_const_get(mod, rb_intern("Client"));
   clients = subextSubtlextWindowList("_NET_CLIENT_LIST", &nclients);
-  visible = (unsigned long *)subSharedPropertyGet(display,
-    DefaultRootWindow(display), XA_CARDINAL, XInternAtom(display,
-    "SUBTLE_VISIBLE_TAGS", False), NULL);
 
   /* Check results */
-  if(clients && visible)
+  if(clients && subextSubtlextTagsProperty(DefaultRootWindow(display),
+      "SUBTLE_VISIBLE_TAGS", &visible))
     {
       for(i = 0; i < nclients; i++)
         {
-          unsigned long *tags = (unsigned long *)subSharedPropertyGet(display,
-            clients[i], XA_CARDINAL, XInternAtom(display,
-            "SUBTLE_CLIENT_TAGS", False), NULL);
+          SubTags tags;
 
           /* Create client on match */
-          if(tags && *tags && *visible & *tags &&
+          if(subextSubtlextTagsProperty(clients[i], "SUBTLE_CLIENT_TAGS",
+              &tags) && subSharedTagsAny(&visible, &tags) &&
               RTEST(client = rb_funcall(klass, meth, 1, LONG2NUM(clients[i]))))
             {
               subextClientUpdate(client);
               rb_ary_push(array, client);
             }
-
-          if(tags) free(tags);
         }
     }
 
   if(clients) free(clients);
-  if(visible) free(visible);
 
   return array;
 } /* }}} */
@@ -446,7 +440,7 @@ subextClientSingList(VALUE self)
 /*
  * call-seq: recent -> Array
  *
- * Get array of the last five active Clients.
+ * Get array of all recently active Clients, most recent first.
  *
  *  Subtlext::Client.recent
  *  => [ #<Subtlext::Client:xxx> ]
@@ -465,7 +459,7 @@ subextClientSingRecent(VALUE self)
   meth    = rb_intern("new");
   array   = rb_ary_new();
   klass   = rb_const_get(mod, rb_intern("Client"));
-  clients = subextSubtlextWindowList("_NET_ACTIVE_WINDOW", &nclients);
+  clients = subextSubtlextWindowList("SUBTLE_FOCUS_HISTORY", &nclients);
 
   /* Check results */
   if(clients)
@@ -598,7 +592,8 @@ subextClientUpdate(VALUE self)
   /* Check values */
   if(0 <= (win = NUM2LONG(rb_iv_get(self, "@win"))))
     {
-      int *tags = NULL, *flags = NULL;
+      int *flags = NULL;
+      SubTags tags;
       char *wmname = NULL, *wminstance = NULL, *wmclass = NULL, *role = NULL;
 
       /* Fetch name, instance and class */
@@ -606,15 +601,14 @@ subextClientUpdate(VALUE self)
       subSharedPropertyName(display, win, &wmname, wmclass);
 
       /* Fetch tags, flags and role */
-      tags  = (int *)subSharedPropertyGet(display, win, XA_CARDINAL,
-        XInternAtom(display, "SUBTLE_CLIENT_TAGS", False), NULL);
+      subextSubtlextTagsProperty(win, "SUBTLE_CLIENT_TAGS", &tags);
       flags = (int *)subSharedPropertyGet(display, win, XA_CARDINAL,
         XInternAtom(display, "SUBTLE_CLIENT_FLAGS", False), NULL);
       role  = subSharedPropertyGet(display, win, XA_STRING,
         XInternAtom(display, "WM_WINDOW_ROLE", False), NULL);
 
       /* Set properties */
-      rb_iv_set(self, "@tags",     tags  ? INT2FIX(*tags)  : INT2FIX(0));
+      rb_iv_set(self, "@tags",     subextSubtlextTagsToValue(&tags));
       rb_iv_set(self, "@flags",    flags ? INT2FIX(*flags) : INT2FIX(0));
       rb_iv_set(self, "@name",     rb_str_new2(wmname));
       rb_iv_set(self, "@instance", rb_str_new2(wminstance));
@@ -625,7 +619,6 @@ subextClientUpdate(VALUE self)
       rb_iv_set(self, "@geometry", Qnil);
       rb_iv_set(self, "@gravity",  Qnil);
 
-      if(tags)  free(tags);
       if(flags) free(flags);
       if(role)  free(role);
       free(wmname);
@@ -653,10 +646,11 @@ subextClientUpdate(VALUE self)
 VALUE
 subextClientViewList(VALUE self)
 {
-  int i, nnames = 0;
+  int i, nnames = 0, nviews = 0, found = False;
   char **names = NULL;
   VALUE win = Qnil, array = Qnil, method = Qnil, klass = Qnil;
-  unsigned long *view_tags = NULL, *client_tags = NULL, *flags = NULL;
+  unsigned long *flags = NULL;
+  SubTags *view_tags = NULL, client_tags;
 
   /* Check ruby object */
   rb_check_frozen(self);
@@ -670,21 +664,19 @@ subextClientViewList(VALUE self)
   array   = rb_ary_new();
   names   = subSharedPropertyGetStrings(display, DefaultRootWindow(display),
     XInternAtom(display, "_NET_DESKTOP_NAMES", False), &nnames);
-  view_tags   = (unsigned long *)subSharedPropertyGet(display,
-    DefaultRootWindow(display), XA_CARDINAL, XInternAtom(display,
-    "SUBTLE_VIEW_TAGS", False), NULL);
-  client_tags = (unsigned long *)subSharedPropertyGet(display, NUM2LONG(win),
-    XA_CARDINAL, XInternAtom(display, "SUBTLE_CLIENT_TAGS", False), NULL);
-  flags       = (unsigned long *)subSharedPropertyGet(display, NUM2LONG(win),
+  view_tags = subextSubtlextViewTags(&nviews);
+  found     = subextSubtlextTagsProperty(NUM2LONG(win), "SUBTLE_CLIENT_TAGS",
+    &client_tags);
+  flags     = (unsigned long *)subSharedPropertyGet(display, NUM2LONG(win),
     XA_CARDINAL, XInternAtom(display, "SUBTLE_CLIENT_FLAGS", False), NULL);
 
   /* Check results */
-  if(names && view_tags && client_tags)
+  if(names && view_tags && found)
     {
-      for(i = 0; i < nnames; i++)
+      for(i = 0; i < nnames && i < nviews; i++)
         {
           /* Check if there are common tags or window is stick */
-          if((view_tags[i] & *client_tags) ||
+          if(subSharedTagsAny(&view_tags[i], &client_tags) ||
               (flags && *flags & SUB_EWMH_STICK))
             {
               /* Create new view */
@@ -699,7 +691,6 @@ subextClientViewList(VALUE self)
 
   if(names)       XFreeStringList(names);
   if(view_tags)   free(view_tags);
-  if(client_tags) free(client_tags);
   if(flags)       free(flags);
 
   return array;
@@ -52,7 +52,10 @@ IconSweep(SubtlextIcon *i)
     {
       /* Check if we can kill the pixmap here */
       if(!(i->flags & ICON_FOREIGN) && i->pixmap)
-        XFreePixmap(display, i->pixmap);
+        {
+          subSharedDrawIconFlush(display, i->pixmap);
+          XFreePixmap(display, i->pixmap);
+        }
 
       if(0 != i->gc) XFreeGC(display, i->gc);
 
@@ -109,6 +109,74 @@ subextSubtleSingAskRunning(VALUE self)
   return running;
 } /* }}} */
 
+/* subextSubtleSingStats {{{ */
+/*
+ * call-seq: stats -> Hash
+ *
+ * Get GC stats of subtle, times are in microseconds, and usage of
+ * the object pools.
+ *
+ *  Subtlext::Subtle.stats
+ *  => { :steps => 42, :major => 3, :last => 812, :max => 9120,
+ *       :total => 60231, :count => 57, :pools => {
+ *       :clients => { :used => 5, :peak => 7, :allocs => 9, :frees => 4,
+ *       :slabs => 1 }, ... } }
+ */
+
+VALUE
+subextSubtleSingStats(VALUE self)
+{
+  int i, j;
+  unsigned long nstats = 0, *stats = NULL;
+  VALUE hash = Qnil, pools = Qnil;
+  const char *names[] = {
+    "steps", "major", "last", "max", "total", "count"
+  };
+  const char *pnames[] = { "clients", "trays", "panels", "items" };
+  const char *fields[] = { "used", "peak", "allocs", "frees", "slabs" };
+
+  subextSubtlextConnect(NULL); ///< Implicit open connection
+
+  hash = rb_hash_new();
+
+  /* Check result */
+  if((stats = (unsigned long *)subSharedPropertyGet(display,
+      DefaultRootWindow(display), XA_CARDINAL,
+      XInternAtom(display, "SUBTLE_GC", False), &nstats)))
+    {
+      for(i = 0; i < nstats && i < LENGTH(names); i++)
+        rb_hash_aset(hash, CHAR2SYM(names[i]), LONG2NUM(stats[i]));
+
+      free(stats);
+    }
+
+  /* Pool stats */
+  if((stats = (unsigned long *)subSharedPropertyGet(display,
+      DefaultRootWindow(display), XA_CARDINAL,
+      XInternAtom(display, "SUBTLE_POOLS", False), &nstats)))
+    {
+      pools = rb_hash_new();
+
+      for(i = 0; i < LENGTH(pnames) &&
+          (i + 1) * LENGTH(fields) <= nstats; i++)
+        {
+          VALUE pool = rb_hash_new();
+
+          for(j = 0; j < LENGTH(fields); j++)
+            rb_hash_aset(pool, CHAR2SYM(fields[j]),
+              LONG2NUM(stats[i * LENGTH(fields) + j]));
+
+          rb_hash_aset(pools, CHAR2SYM(pnames[i]), pool);
+        }
+
+      rb_hash_aset(hash, CHAR2SYM("pools"), pools);
+
+      free(stats);
+    }
+
+  return hash;
+} /* }}} */
+
 /* subextSubtleSingSelect {{{ */
 /*
  * call-seq: select_window -> Fixnum
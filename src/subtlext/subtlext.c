@@ -209,14 +209,54 @@ SubtlextXError(Display *disp,
   return 0;
 } /* }}} */
 
+/* SubtlextNameIndex {{{ */
+static int
+SubtlextNameIndex(char *prop_name,
+  char *source)
+{
+  int ret = -2;
+  unsigned long i, size = 0, *names = NULL;
+
+  /* Fetch name index */
+  if((names = (unsigned long *)subSharedPropertyGet(display, ROOT,
+      XA_CARDINAL, XInternAtom(display, "SUBTLE_NAME_INDEX", False),
+      &size)))
+    {
+      unsigned long long hash = subSharedStringHash(source);
+      unsigned long lo = (unsigned long)(hash & 0xffffffffULL);
+      unsigned long hi = (unsigned long)(hash >> 32);
+      Atom list = XInternAtom(display, prop_name, False);
+
+      /* Check quadruples of 64bit hash, list atom and id */
+      for(ret = -1, i = 0; i + 3 < size; i += 4)
+        {
+          if(list == names[i + 2] && lo == (names[i] & 0xffffffffUL) &&
+              hi == (names[i + 1] & 0xffffffffUL))
+            {
+              /* Let caller compare strings on duplicate names */
+              if(-1 != ret)
+                {
+                  ret = -2;
+                  break;
+                }
+
+              ret = (int)names[i + 3];
+            }
+        }
+
+      free(names);
+    }
+
+  return ret;
+} /* }}} */
+
 /* Tags */
 
 /* SubtlextTagFind {{{ */
-static int
-SubtlextTagFind(VALUE value)
+static void
+SubtlextTagFind(VALUE value,
+  SubTags *tags)
 {
-  int tags = 0;
-
   /* Check object type */
   switch(rb_type(value))
     {
@@ -237,7 +277,7 @@ SubtlextTagFind(VALUE value)
             /* Find tag and get id */
             if(-1 != (id = subextSubtlextFindString("SUBTLE_TAG_LIST",
                 string, NULL, flags)))
-              tags |= (1L << (id + 1));
+              subSharedTagsSet(tags, id);
           }
         break;
       case T_OBJECT:
@@ -247,7 +287,7 @@ SubtlextTagFind(VALUE value)
             VALUE id = Qnil;
 
             if(FIXNUM_P((id = rb_iv_get(value, "@id"))))
-              tags |= (1L << (FIX2INT(id) + 1));
+              subSharedTagsSet(tags, FIX2INT(id));
           }
         break;
       case T_ARRAY:
@@ -258,15 +298,13 @@ SubtlextTagFind(VALUE value)
             /* Collect tags and raise if a tag wasn't found. Empty
              * arrays reset tags and never enter this loop */
             for(i = 0; Qnil != (entry = rb_ary_entry(value, i)); ++i)
-              tags |= SubtlextTagFind(entry);
+              SubtlextTagFind(entry, tags);
           }
         break;
       default:
         rb_raise(rb_eArgError, "Unexpected value-type `%s'",
           rb_obj_classname(value));
     }
-
-  return tags;
 } /* }}} */
 
 /* SubtlextTag {{{ */
@@ -275,33 +313,42 @@ SubtlextTag(VALUE self,
   VALUE value,
   int action)
 {
+  char *type = NULL;
+  long cards[TAGSCARDS + 1] = { 0 };
+  Window win = DefaultRootWindow(display);
+  Atom prop = XInternAtom(display, "SUBTLE_TAGS", False);
+  SubTags tags, current;
   SubMessageData data = { { 0, 0, 0, 0, 0 } };
 
   /* Check ruby object */
   rb_check_frozen(self);
 
   /* Convert tags to bitmask */
-  data.l[1] |= SubtlextTagFind(value);
+  subSharedTagsClear(&tags);
+  SubtlextTagFind(value, &tags);
 
   /* Get and update tag mask */
-  if(0 != action)
+  subextSubtlextValueToTags(rb_iv_get(self, "@tags"), &current);
+
+  if(1 == action)
+    subSharedTagsOr(&tags, &current);
+  else if(-1 == action)
     {
-      int tags = FIX2INT(rb_iv_get(self, "@tags"));
+      SubTags removed = tags;
 
-      /* Update masks */
-     if(1 == action)       data.l[1] = tags |  data.l[1];
-     else if(-1 == action) data.l[1] = tags & ~data.l[1];
+      tags = current;
+      subSharedTagsAndNot(&tags, &removed);
     }
 
   /* Send message based on object type */
   if(rb_obj_is_instance_of(self, rb_const_get(mod, rb_intern("Client"))))
     {
-      VALUE win = Qnil;
-
-      GET_ATTR(self, "@win", win);
-      data.l[0] = NUM2LONG(win);
+      VALUE val = Qnil;
 
-      subSharedMessage(display, ROOT, "SUBTLE_CLIENT_TAGS", data, 32, True);
+      GET_ATTR(self, "@win", val);
+      data.l[0] = NUM2LONG(val);
+      win       = data.l[0]; ///< Store tags on the client window
+      type      = "SUBTLE_CLIENT_TAGS";
     }
   else
     {
@@ -309,10 +356,22 @@ SubtlextTag(VALUE self,
 
       GET_ATTR(self, "@id", id);
       data.l[0] = FIX2LONG(id);
-
-      subSharedMessage(display, ROOT, "SUBTLE_VIEW_TAGS", data, 32, True);
+      type      = "SUBTLE_VIEW_TAGS";
     }
 
+  /* Store id and all cardinals in a property and send one message
+   * naming it, subtle drops it when the id doesn't match */
+  cards[0] = data.l[0];
+  subSharedTagsToCards(&tags, cards + 1);
+
+  XChangeProperty(display, win, prop, XA_CARDINAL, 32, PropModeReplace,
+    (unsigned char *)cards, LENGTH(cards));
+
+  data.l[1] = win;
+  data.l[2] = prop;
+
+  subSharedMessage(display, ROOT, type, data, 32, True);
+
   return Qnil;
 } /* }}} */
 
@@ -352,7 +411,8 @@ static VALUE
 SubtlextTagReader(VALUE self)
 {
   char **tags = NULL;
-  int i, ntags = 0, value_tags = 0;
+  int i, ntags = 0;
+  SubTags value_tags;
   VALUE method = Qnil, klass = Qnil, t = Qnil;
   VALUE array = rb_ary_new();
 
@@ -360,9 +420,9 @@ SubtlextTagReader(VALUE self)
   rb_check_frozen(self);
 
   /* Fetch data */
-  method     = rb_intern("new");
-  klass      = rb_const_get(mod, rb_intern("Tag"));
-  value_tags = FIX2INT(rb_iv_get(self, "@tags"));
+  method = rb_intern("new");
+  klass  = rb_const_get(mod, rb_intern("Tag"));
+  subextSubtlextValueToTags(rb_iv_get(self, "@tags"), &value_tags);
 
   /* Check results */
   if((tags = subSharedPropertyGetStrings(display, ROOT,
@@ -370,7 +430,7 @@ SubtlextTagReader(VALUE self)
     {
       for(i = 0; i < ntags; i++)
         {
-          if(value_tags & (1L << (i + 1)))
+          if(subSharedTagsTest(&value_tags, i))
             {
               /* Create new tag */
               t = rb_funcall(klass, method, 1, rb_str_new2(tags[i]));
@@ -456,13 +516,14 @@ SubtlextTagAsk(VALUE self,
   /* Find tag */
   if(RTEST(tag = subextTagSingFirst(Qnil, sym)))
     {
-      VALUE id = Qnil, tags = Qnil;
+      SubTags tags;
+      VALUE id = Qnil;
 
       /* Get properties */
-      id   = rb_iv_get(tag,  "@id");
-      tags = rb_iv_get(self, "@tags");
+      id = rb_iv_get(tag,  "@id");
+      subextSubtlextValueToTags(rb_iv_get(self, "@tags"), &tags);
 
-      if(FIX2INT(tags) & (1L << (FIX2INT(id) + 1))) ret = Qtrue;
+      if(subSharedTagsTest(&tags, FIX2INT(id))) ret = Qtrue;
     }
 
   return ret;
@@ -1474,6 +1535,101 @@ subextSubtlextWindowList(char *prop_name,
   return wins;
 } /* }}} */
 
+ /** subextSubtlextTagsProperty {{{
+  * @brief Get tags from cardinal property
+  * @param[in]     win        Window
+  * @param[in]     prop_name  Property name
+  * @param[inout]  tags       A #SubTags
+  * @retval  True   Property found
+  * @retval  False  Property not found
+  **/
+
+int
+subextSubtlextTagsProperty(Window win,
+  char *prop_name,
+  SubTags *tags)
+{
+  long *cards = NULL;
+  unsigned long size = 0;
+
+  assert(prop_name && tags);
+
+  cards = (long *)subSharedPropertyGet(display, win, XA_CARDINAL,
+    XInternAtom(display, prop_name, False), &size);
+
+  subSharedTagsFromCards(tags, cards, size);
+
+  if(cards) free(cards);
+
+  return NULL != cards;
+} /* }}} */
+
+ /** subextSubtlextViewTags {{{
+  * @brief Get tags of all views
+  * @param[inout]  size  Number of views
+  * @return Tags of all views or \p NULL
+  **/
+
+SubTags *
+subextSubtlextViewTags(int *size)
+{
+  int i, nviews = 0;
+  long *cards = NULL;
+  unsigned long ncards = 0;
+  SubTags *tags = NULL;
+
+  /* Each view has a fixed number of cardinals */
+  if((cards = (long *)subSharedPropertyGet(display, ROOT, XA_CARDINAL,
+      XInternAtom(display, "SUBTLE_VIEW_TAGS", False), &ncards)))
+    {
+      nviews = ncards / TAGSCARDS;
+      tags   = (SubTags *)subSharedMemoryAlloc(nviews + 1, sizeof(SubTags));
+
+      for(i = 0; i < nviews; i++)
+        subSharedTagsFromCards(&tags[i], cards + i * TAGSCARDS, TAGSCARDS);
+
+      free(cards);
+    }
+
+  if(size) *size = nviews;
+
+  return tags;
+} /* }}} */
+
+ /** subextSubtlextTagsToValue {{{
+  * @brief Convert tags to ruby integer
+  * @param[in]  tags  A #SubTags
+  * @return Integer with same bit layout
+  **/
+
+VALUE
+subextSubtlextTagsToValue(SubTags *tags)
+{
+  assert(tags);
+
+  return rb_integer_unpack(tags->bits, TAGSWORDS, sizeof(unsigned long), 0,
+    INTEGER_PACK_LSWORD_FIRST|INTEGER_PACK_NATIVE_BYTE_ORDER);
+} /* }}} */
+
+ /** subextSubtlextValueToTags {{{
+  * @brief Convert ruby integer to tags
+  * @param[in]     value  Integer value
+  * @param[inout]  tags   A #SubTags
+  **/
+
+void
+subextSubtlextValueToTags(VALUE value,
+  SubTags *tags)
+{
+  assert(tags);
+
+  subSharedTagsClear(tags);
+
+  if(RB_INTEGER_TYPE_P(value))
+    rb_integer_pack(value, tags->bits, TAGSWORDS, sizeof(unsigned long), 0,
+      INTEGER_PACK_LSWORD_FIRST|INTEGER_PACK_NATIVE_BYTE_ORDER);
+} /* }}} */
+
  /** subextSubtlextFindString {{{
   * @brief Find string in property list
   * @param[in]     prop_name  Property name
@@ -1496,7 +1652,17 @@ subextSubtlextFindString(char *prop_name,
 
   assert(prop_name && source);
 
+  /* Resolve exact names via index */
+  if(flags & SUB_MATCH_EXACT && !isdigit(source[0]) &&
+      -2 != (ret = SubtlextNameIndex(prop_name, source)))
+    {
+      if(name && -1 != ret) *name = strdup(source);
+
+      return ret;
+    }
+
   /* Fetch data */
+  ret     = -1;
   preg    = subSharedRegexNew(source);
   strings = subSharedPropertyGetStrings(display, ROOT,
     XInternAtom(display, prop_name, False), &size);
@@ -1555,6 +1721,30 @@ subextSubtlextFindObjects(char *prop_name,
 
   assert(prop_name && class_name && source);
 
+  /* Resolve exact names via index */
+  if(flags & SUB_MATCH_EXACT && !isdigit(source[0]) &&
+      -2 != (i = SubtlextNameIndex(prop_name, source)))
+    {
+      VALUE obj = Qnil, meth_update = rb_intern("update");
+
+      if(-1 == i) return ret;
+
+      /* Create new object */
+      if(RTEST((obj = rb_funcall(rb_const_get(mod, rb_intern(class_name)),
+          rb_intern("new"), 1, rb_str_new2(source)))))
+        {
+          rb_iv_set(obj, "@id", INT2FIX(i));
+
+          /* Call update method of object */
+          if(rb_respond_to(obj, meth_update))
+            rb_funcall(obj, meth_update, 0, Qnil);
+
+          ret = first ? obj : subextSubtlextOneOrMany(obj, ret);
+        }
+
+      return ret;
+    }
+
   /* Check results */
   if((strings = subSharedPropertyGetStrings(display, ROOT,
       XInternAtom(display, prop_name, False), &nstrings)))
@@ -1797,6 +1987,15 @@ Init_subtlext(void)
   /* Subtlext version */
   rb_define_const(mod, "VERSION", rb_str_new2(PKG_VERSION));
 
+  /* Bypass X when loaded into subtle */
+  if(rb_const_defined(rb_cObject, rb_intern("Subtle")))
+    {
+      VALUE direct = rb_ivar_get(rb_const_get(rb_cObject,
+        rb_intern("Subtle")), rb_intern("__direct"));
+
+      if(T_DATA == rb_type(direct)) subSharedDirect(DATA_PTR(direct));
+    }
+
   /*
    * Document-class: Subtlext::Client
    *
@@ -2114,6 +2313,7 @@ Init_subtlext(void)
   rb_define_singleton_method(subtle, "display=",      subextSubtleSingDisplayWriter, 1);
   rb_define_singleton_method(subtle, "select_window", subextSubtleSingSelect,        0);
   rb_define_singleton_method(subtle, "running?",      subextSubtleSingAskRunning,    0);
+  rb_define_singleton_method(subtle, "stats",         subextSubtleSingStats,         0);
   rb_define_singleton_method(subtle, "render",        subextSubtleSingRender,        0);
   rb_define_singleton_method(subtle, "reload",        subextSubtleSingReload,        0);
   rb_define_singleton_method(subtle, "restart",       subextSubtleSingRestart,       0);
@@ -196,6 +196,7 @@ VALUE subextSubtleSingDisplayReader(VALUE self);                     ///< Get di
 VALUE subextSubtleSingDisplayWriter(VALUE self, VALUE display);      ///< Set display
 VALUE subextSubtleSingAskRunning(VALUE self);                        ///< Is subtle running
 VALUE subextSubtleSingSelect(VALUE self);                            ///< Select window
+VALUE subextSubtleSingStats(VALUE self);                             ///< Get GC stats
 VALUE subextSubtleSingRender(VALUE self);                            ///< Render panels
 VALUE subextSubtleSingReload(VALUE self);                            ///< Reload config and sublets
 VALUE subextSubtleSingRestart(VALUE self);                           ///< Restart subtle
@@ -213,6 +214,11 @@ VALUE subextSubtlextParse(VALUE value, char *buf,
 VALUE subextSubtlextOneOrMany(VALUE value, VALUE prev);              ///< Return one or many
 VALUE subextSubtlextManyToOne(VALUE value);                          ///< Return one from many
 Window *subextSubtlextWindowList(char *prop_name, int *size);        ///< Get window list
+int subextSubtlextTagsProperty(Window win, char *prop_name,
+  SubTags *tags);                                                     ///< Get tags property
+SubTags *subextSubtlextViewTags(int *size);                           ///< Get tags of views
+VALUE subextSubtlextTagsToValue(SubTags *tags);                       ///< Convert tags to value
+void subextSubtlextValueToTags(VALUE value, SubTags *tags);           ///< Convert value to tags
 int subextSubtlextFindString(char *prop_name, char *source,
   char **name, int flags);                                        ///< Find string id
 VALUE subextSubtlextFindObjects(char *prop_name, char *class_name,
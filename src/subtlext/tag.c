@@ -120,9 +120,9 @@ subextTagSingFirst(VALUE self,
 VALUE
 subextTagSingVisible(VALUE self)
 {
-  int i, ntags = 0;
+  int i, ntags = 0, found = False;
   char **tags = NULL;
-  unsigned long *visible = NULL;
+  SubTags visible;
   VALUE meth = Qnil, klass = Qnil, array = Qnil, t = Qnil;
 
   subextSubtlextConnect(NULL); ///< Implicit open connection
@@ -133,17 +133,16 @@ subextTagSingVisible(VALUE self)
   array   = rb_ary_new();
   tags    = subSharedPropertyGetStrings(display, DefaultRootWindow(display),
     XInternAtom(display, "SUBTLE_TAG_LIST", False), &ntags);
-  visible = (unsigned long *)subSharedPropertyGet(display,
-    DefaultRootWindow(display), XA_CARDINAL, XInternAtom(display,
-    "SUBTLE_VISIBLE_TAGS", False), NULL);
+  found   = subextSubtlextTagsProperty(DefaultRootWindow(display),
+    "SUBTLE_VISIBLE_TAGS", &visible);
 
   /* Populate array */
-  if(tags && visible)
+  if(tags && found)
     {
       for(i = 0; i < ntags; i++)
         {
           /* Create tag on match */
-          if(*visible & (1L << (i + 1)) &&
+          if(subSharedTagsTest(&visible, i) &&
               !NIL_P(t = rb_funcall(klass, meth, 1, rb_str_new2(tags[i]))))
             {
               rb_iv_set(t, "@id", INT2FIX(i));
@@ -153,8 +152,7 @@ subextTagSingVisible(VALUE self)
 
     }
 
-  if(tags)    XFreeStringList(tags);
-  if(visible) free(visible);
+  if(tags) XFreeStringList(tags);
 
   return array;
 } /* }}} */
@@ -328,7 +326,7 @@ subextTagClients(VALUE self)
 {
   int i, nclients = 0;
   Window *clients = NULL;
-  unsigned long *tags = NULL;
+  SubTags tags;
   VALUE id = Qnil, array = Qnil, klass = Qnil, meth = Qnil, c = Qnil;
 
   /* Check ruby object */
@@ -346,12 +344,11 @@ subextTagClients(VALUE self)
     {
       for(i = 0; i < nclients; i++)
         {
-          if((tags = (unsigned long *)subSharedPropertyGet(display,
-              clients[i], XA_CARDINAL, XInternAtom(display,
-              "SUBTLE_CLIENT_TAGS", False), NULL)))
+          if(subextSubtlextTagsProperty(clients[i], "SUBTLE_CLIENT_TAGS",
+              &tags))
             {
               /* Check if tag id matches */
-              if(*tags & (1L << (FIX2INT(id) + 1)))
+              if(subSharedTagsTest(&tags, FIX2INT(id)))
                 {
                   /* Create new client */
                   if(!NIL_P(c = rb_funcall(klass, meth, 1,
@@ -387,9 +384,9 @@ subextTagClients(VALUE self)
 VALUE
 subextTagViews(VALUE self)
 {
-  int i, nnames = 0;
+  int i, nnames = 0, nviews = 0;
   char **names = NULL;
-  unsigned long *tags = NULL;
+  SubTags *tags = NULL;
   VALUE id = Qnil, array = Qnil, klass = Qnil, meth = Qnil, v = Qnil;
 
   /* Check ruby object */
@@ -404,17 +401,15 @@ subextTagViews(VALUE self)
   array  = rb_ary_new();
   names  = subSharedPropertyGetStrings(display, DefaultRootWindow(display),
     XInternAtom(display, "_NET_DESKTOP_NAMES", False), &nnames);
-  tags   = (unsigned long *)subSharedPropertyGet(display,
-    DefaultRootWindow(display), XA_CARDINAL,
-    XInternAtom(display, "SUBTLE_VIEW_TAGS", False), NULL);
+  tags   = subextSubtlextViewTags(&nviews);
 
   /* Check results */
   if(names && tags)
     {
-      for(i = 0; i < nnames; i++)
+      for(i = 0; i < nnames && i < nviews; i++)
         {
           /* Check if tag id matches */
-          if(tags[i] & (1L << (FIX2INT(id) + 1)))
+          if(subSharedTagsTest(&tags[i], FIX2INT(id)))
             {
               /* Create new view */
               if(!NIL_P(v = rb_funcall(klass, meth, 1, rb_str_new2(names[i]))))
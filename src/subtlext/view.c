@@ -161,9 +161,9 @@ subextViewSingFirst(VALUE self,
 VALUE
 subextViewSingCurrent(VALUE self)
 {
-  int nnames = 0;
+  int nnames = 0, nviews = 0;
   char **names = NULL;
-  long *tags = NULL;
+  SubTags *tags = NULL;
   unsigned long *cur_view = NULL;
   VALUE view = Qnil;
 
@@ -175,17 +175,16 @@ subextViewSingCurrent(VALUE self)
   cur_view = (unsigned long *)subSharedPropertyGet(display,
     DefaultRootWindow(display), XA_CARDINAL,
     XInternAtom(display, "_NET_CURRENT_DESKTOP", False), NULL);
-  tags     = (long *)subSharedPropertyGet(display, ROOT, XA_CARDINAL,
-      XInternAtom(display, "SUBTLE_VIEW_TAGS", False), NULL);
+  tags     = subextSubtlextViewTags(&nviews);
 
   /* Check results */
-  if(names && cur_view && tags)
+  if(names && cur_view && tags && *cur_view < nviews)
     {
       /* Create instance */
       view = subextViewInstantiate(names[*cur_view]);
 
       rb_iv_set(view, "@id",   INT2FIX(*cur_view));
-      rb_iv_set(view, "@tags", LONG2NUM(tags[*cur_view]));
+      rb_iv_set(view, "@tags", subextSubtlextTagsToValue(&tags[*cur_view]));
     }
 
   if(names)    XFreeStringList(names);
@@ -211,9 +210,9 @@ subextViewSingCurrent(VALUE self)
 VALUE
 subextViewSingVisible(VALUE self)
 {
-  int i, nnames = 0, *tags = NULL;
+  int i, nnames = 0, nviews = 0, found = False;
   char **names = NULL;
-  unsigned long *visible = NULL;
+  SubTags *tags = NULL, visible;
   VALUE meth = Qnil, klass = Qnil, array = Qnil, v = Qnil;
 
   subextSubtlextConnect(NULL); ///< Implicit open connection
@@ -224,32 +223,29 @@ subextViewSingVisible(VALUE self)
   array = rb_ary_new();
   names = subSharedPropertyGetStrings(display, DefaultRootWindow(display),
     XInternAtom(display, "_NET_DESKTOP_NAMES", False), &nnames);
-  visible = (unsigned long *)subSharedPropertyGet(display,
-    DefaultRootWindow(display), XA_CARDINAL, XInternAtom(display,
-    "SUBTLE_VISIBLE_VIEWS", False), NULL);
-  tags  = (int *)subSharedPropertyGet(display, ROOT, XA_CARDINAL,
-      XInternAtom(display, "SUBTLE_VIEW_TAGS", False), NULL);
+  found = subextSubtlextTagsProperty(DefaultRootWindow(display),
+    "SUBTLE_VISIBLE_VIEWS", &visible);
+  tags  = subextSubtlextViewTags(&nviews);
 
   /* Check results */
-  if(names && visible && tags)
+  if(names && found && tags)
     {
-      for(i = 0; i < nnames; i++)
+      for(i = 0; i < nnames && i < nviews; i++)
         {
           /* Create view on match */
-          if(*visible & (1L << (i + 1)) &&
+          if(subSharedTagsTest(&visible, i) &&
               !NIL_P(v = rb_funcall(klass, meth, 1, rb_str_new2(names[i]))))
             {
               rb_iv_set(v, "@id",   INT2FIX(i));
-              rb_iv_set(v, "@tags", INT2FIX(tags[i]));
+              rb_iv_set(v, "@tags", subextSubtlextTagsToValue(&tags[i]));
 
               rb_ary_push(array, v);
             }
         }
     }
 
-  if(names)   XFreeStringList(names);
-  if(visible) free(visible);
-  if(tags)    free(tags);
+  if(names) XFreeStringList(names);
+  if(tags)  free(tags);
 
   return array;
 } /* }}} */
@@ -271,8 +267,8 @@ subextViewSingVisible(VALUE self)
 VALUE
 subextViewSingList(VALUE self)
 {
-  int i, nnames = 0;
-  long *tags = NULL;
+  int i, nnames = 0, nviews = 0;
+  SubTags *tags = NULL;
   char **names = NULL;
   VALUE meth = Qnil, klass = Qnil, array = Qnil, v = Qnil;
 
@@ -284,18 +280,17 @@ subextViewSingList(VALUE self)
   array = rb_ary_new();
   names = subSharedPropertyGetStrings(display, DefaultRootWindow(display),
       XInternAtom(display, "_NET_DESKTOP_NAMES", False), &nnames);
-  tags  = (long *)subSharedPropertyGet(display, ROOT, XA_CARDINAL,
-      XInternAtom(display, "SUBTLE_VIEW_TAGS", False), NULL);
+  tags  = subextSubtlextViewTags(&nviews);
 
   /* Check results */
   if(names && tags)
     {
-      for(i = 0; i < nnames; i++)
+      for(i = 0; i < nnames && i < nviews; i++)
         {
           if(!NIL_P(v = rb_funcall(klass, meth, 1, rb_str_new2(names[i]))))
             {
               rb_iv_set(v, "@id",   INT2FIX(i));
-              rb_iv_set(v, "@tags", LONG2NUM(tags[i]));
+              rb_iv_set(v, "@tags", subextSubtlextTagsToValue(&tags[i]));
 
               rb_ary_push(array, v);
             }
@@ -370,7 +365,8 @@ subextViewInit(VALUE self,
 VALUE
 subextViewUpdate(VALUE self)
 {
-  long *tags = NULL, ntags = 0;
+  int nviews = 0;
+  SubTags *tags = NULL;
   VALUE id = Qnil;
 
   /* Check ruby object */
@@ -380,12 +376,12 @@ subextViewUpdate(VALUE self)
   subextSubtlextConnect(NULL); ///< Implicit open connection
 
   /* Fetch tags */
-  if((tags = (long *)subSharedPropertyGet(display, ROOT, XA_CARDINAL,
-      XInternAtom(display, "SUBTLE_VIEW_TAGS", False), (unsigned long *)&ntags)))
+  if((tags = subextSubtlextViewTags(&nviews)))
     {
       int idx = FIX2INT(id);
 
-      rb_iv_set(self, "@tags", LONG2NUM(idx < ntags ? tags[idx] : 0));
+      rb_iv_set(self, "@tags", idx < nviews ?
+        subextSubtlextTagsToValue(&tags[idx]) : INT2FIX(0));
 
       free(tags);
     }
@@ -470,7 +466,8 @@ subextViewClients(VALUE self)
   int i, nclients = 0;
   Window *clients = NULL;
   VALUE id = Qnil, klass = Qnil, meth = Qnil, array = Qnil, client = Qnil;
-  unsigned long *view_tags = NULL;
+  int nviews = 0;
+  SubTags *view_tags = NULL;
 
   /* Check ruby object */
   rb_check_frozen(self);
@@ -483,27 +480,27 @@ subextViewClients(VALUE self)
   meth      = rb_intern("new");
   array     = rb_ary_new();
   clients   = subextSubtlextWindowList("_NET_CLIENT_LIST", &nclients);
-  view_tags = (unsigned long *)subSharedPropertyGet(display,
-    DefaultRootWindow(display), XA_CARDINAL,
-    XInternAtom(display, "SUBTLE_VIEW_TAGS", False), NULL);
+  view_tags = subextSubtlextViewTags(&nviews);
 
   /* Check results */
-  if(clients && view_tags)
+  if(clients && view_tags && FIX2INT(id) < nviews)
     {
       for(i = 0; i < nclients; i++)
         {
-          unsigned long *client_tags = NULL, *flags = NULL;
+          int found = False;
+          unsigned long *flags = NULL;
+          SubTags client_tags;
 
           /* Fetch window data */
-          client_tags = (unsigned long *)subSharedPropertyGet(display,
-            clients[i], XA_CARDINAL,
-            XInternAtom(display, "SUBTLE_CLIENT_TAGS", False), NULL);
-          flags       = (unsigned long *)subSharedPropertyGet(display,
+          found = subextSubtlextTagsProperty(clients[i], "SUBTLE_CLIENT_TAGS",
+            &client_tags);
+          flags = (unsigned long *)subSharedPropertyGet(display,
             clients[i], XA_CARDINAL,
             XInternAtom(display, "SUBTLE_CLIENT_FLAGS", False), NULL);
 
           /* Check if there are common tags or window is stick */
-          if((client_tags && view_tags[FIX2INT(id)] & *client_tags) ||
+          if((found && subSharedTagsAny(&view_tags[FIX2INT(id)],
+              &client_tags)) ||
               (flags && *flags & SUB_EWMH_STICK))
             {
               if(RTEST(client = rb_funcall(klass, meth,
@@ -515,8 +512,7 @@ subextViewClients(VALUE self)
                 }
             }
 
-          if(client_tags) free(client_tags);
-          if(flags)       free(flags);
+          if(flags) free(flags);
         }
     }
 
@@ -36,6 +36,14 @@ context 'Subtle - Init' do
 
     1 == Subtlext::Client.all.size
   end # }}}
+
+  asserts 'Check pool stats' do # {{{
+    pools = Subtlext::Subtle.stats[:pools]
+
+    pools.is_a?(Hash) and 1 <= pools[:clients][:used] and
+      pools[:clients][:allocs] - pools[:clients][:frees] ==
+        pools[:clients][:used]
+  end # }}}
 end
 
 # vim:ts=2:bs=2:sw=2:et:fdm=marker
@@ -125,6 +125,34 @@ context 'View' do
       1 == after and topic.has_tag?(VIEW_TAG)
   end # }}}
 
+  asserts 'Set more than 32 tags' do # {{{
+    before = topic.tags
+    count  = Subtlext::Tag.all.size
+    names  = 40.times.map { |i| 'view%d' % [ i ] }
+
+    # Create tags past the first cardinal
+    names.each { |name| Subtlext::Tag.new(name).save }
+
+    sleep 1
+
+    topic.tags = names.map { |name| Subtlext::Tag.first(name) }
+
+    sleep 0.5
+
+    topic.update
+    wide = topic.tags.map(&:name).sort == names.sort
+    topic.tags = before
+
+    sleep 0.5
+
+    names.each { |name| Subtlext::Tag.first(name).kill }
+
+    sleep 1
+
+    topic.update
+    wide and before == topic.tags and count == Subtlext::Tag.all.size
+  end # }}}
+
   asserts 'Store values' do # {{{
     topic[:test] = 'test'
 